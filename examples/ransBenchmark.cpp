@@ -1,11 +1,14 @@
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "rapidjson/document.h"
 #include "rapidjson/istreamwrapper.h"
@@ -27,6 +30,10 @@
 namespace json = rapidjson;
 using source_t = SOURCE_T;
 static const uint REPETITIONS = 5;
+static const size_t BLOCK_SIZE = 1 << 20;
+static const size_t PARALLEL_LANES = 4;
+static const size_t SPARSE_SYMBOLS = 1 << 10;
+static const size_t WARMUP_RUNS = 1;
 
 ////////////////////////////////////////////////////////////////
 // use this definition for 32bit coder/decoder
@@ -36,6 +43,13 @@ using coder_t = uint32_t;
 using stream_t = uint8_t;
 using Rans = rans::Coder<coder_t, stream_t>;
 // using RansEncSymbol = rans::EncoderSymbol<coder_t>;
+#elif defined(ransWord)
+////////////////////////////////////////////////////////////////
+// use this definition for 32bit coder/decoder with 16bit word I/O
+static const uint PROB_BITS = 14;
+using coder_t = uint32_t;
+using stream_t = uint16_t;
+using Rans = rans::Coder<coder_t, stream_t>;
 #else
 ////////////////////////////////////////////////////////////////
 // use this definition for 64bit coder/decoder
@@ -52,7 +66,7 @@ static const char USAGE[] =
 
         Usage:
           ransBenchmark
-          ransBenchmark <fileName> [-s <samples>] [-b <bits>] [-r <dict>] [-d <dict>] [-e <createdDict>] [-l <log> ]
+          ransBenchmark <fileName> [-s <samples>] [-b <bits>] [-r <dict>] [-d <dict>] [-e <createdDict>] [-l <log> ] [-t <threads>] [-k <blockSize>] [-o <frame>] [-m <symbols>] [-x <path>] [-c <dir>] [-w <runs>] [-p <cpu>] [-v <level>]
           ransBenchmark (-h | --help)
           ransBenchmark --version
 
@@ -64,7 +78,16 @@ static const char USAGE[] =
           -r <bits> --range <bits>          Range of the source data
           -d <dict> --dict <dict>           Dictionary.
           -e <path> --export <path>         Export dictionary.
+          -x <path> --export-binary <path>  Export dictionary with tables in binary format.
           -l <log> --log <log>              Log in JSON format.    
+          -t <threads> --threads <threads>  Worker threads for block parallel coding.
+          -k <size> --blocksize <size>      Symbols per block for block parallel coding.
+          -o <frame> --output <frame>       Write the block parallel result as a frame.
+          -m <symbols> --sparse <symbols>   Most frequent symbols kept by sparse coding.
+          -c <dir> --cache <dir>            Directory caching prebuilt coder tables.
+          -w <runs> --warmup <runs>         Untimed runs before the measurements.
+          -p <cpu> --pin <cpu>              Pin the timed thread to a CPU.
+          -v <level> --simd <level>         SIMD kernel (Scalar, SSE4.1, AVX2, AVX512), the best supported by default.
 
     )";
 
@@ -119,6 +142,14 @@ int main(int argc, char* argv[]) {
     }
   }();
 
+  const std::string exportBinaryDictPath = [&]() {
+    if (args["--export-binary"].isString()) {
+      return args["--export-binary"].asString();
+    } else {
+      return std::string();
+    }
+  }();
+
   const uint32_t repetitions = [&]() {
     try {
       return static_cast<uint32_t>(args["--samples"].asLong());
@@ -135,6 +166,70 @@ int main(int argc, char* argv[]) {
     }
   }();
 
+  const uint32_t threads = [&]() {
+    try {
+      return static_cast<uint32_t>(args["--threads"].asLong());
+    } catch (std::runtime_error& e) {
+      return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+  }();
+
+  const size_t blockSize = [&]() {
+    try {
+      return static_cast<size_t>(args["--blocksize"].asLong());
+    } catch (std::runtime_error& e) {
+      return BLOCK_SIZE;
+    }
+  }();
+
+  const size_t sparseSymbols = [&]() {
+    try {
+      return static_cast<size_t>(args["--sparse"].asLong());
+    } catch (std::runtime_error& e) {
+      return SPARSE_SYMBOLS;
+    }
+  }();
+
+  const std::string cachePath = [&]() {
+    if (args["--cache"].isString()) {
+      return args["--cache"].asString();
+    } else {
+      return std::string();
+    }
+  }();
+
+  const size_t warmupRuns = [&]() {
+    try {
+      return static_cast<size_t>(args["--warmup"].asLong());
+    } catch (std::runtime_error& e) {
+      return WARMUP_RUNS;
+    }
+  }();
+
+  const int pinnedCpu = [&]() {
+    try {
+      return static_cast<int>(args["--pin"].asLong());
+    } catch (std::runtime_error& e) {
+      return -1;
+    }
+  }();
+
+  [[maybe_unused]] const rans::SIMDLevel simdLevel = [&]() {
+    if (args["--simd"].isString()) {
+      return rans::simdLevelFromString(args["--simd"].asString());
+    } else {
+      return rans::detectSIMDLevel();
+    }
+  }();
+
+  const std::string framePath = [&]() {
+    if (args["--output"].isString()) {
+      return args["--output"].asString();
+    } else {
+      return std::string();
+    }
+  }();
+
   //////////////////////////////////////////////////////////////////////////////////////////
 
   const uint32_t prob_scale = 1 << prob_bits;
@@ -144,6 +239,9 @@ int main(int argc, char* argv[]) {
   std::cout << "Dictionary Path: " << dictPath << std::endl;
   std::cout << "Export Path: " << exportDictPath << std::endl;
   std::cout << "Repetitions: " << repetitions << std::endl;
+  std::cout << "Threads: " << threads << std::endl;
+  std::cout << "Block Size: " << blockSize << std::endl;
+  std::cout << "Table Cache: " << cachePath << std::endl;
 
   runSummary.AddMember(
       "Filename",
@@ -151,26 +249,55 @@ int main(int argc, char* argv[]) {
       runSummary.GetAllocator());
   runSummary.AddMember("ProbabilityBits", prob_bits, runSummary.GetAllocator());
 
-  // Read in file to be compressed
-  std::vector<source_t> tokens;
-  read_file(filename, &tokens);
+  // Map the file to be compressed, tokens are read in place.
+  const rans::MappedFile inputFile(filename);
+  const rans::Span<const source_t> tokens = inputFile.as<source_t>();
   std::cout << std::endl;
   std::cout << "Symbols:" << tokens.size() << std::endl;
   runSummary.AddMember("NumberOfSymbols", tokens.size(),
                        runSummary.GetAllocator());
 
+  rans::ThreadPool pool(threads);
+
+  // pinned after the workers are started, which keep all CPUs.
+  timerSettings().warmupRuns = warmupRuns;
+  if (pinnedCpu >= 0 && !pinToCpu(pinnedCpu)) {
+    std::cout << "WARNING: can not pin to CPU " << pinnedCpu << std::endl;
+  }
+  std::cout << "Warm-up Runs: " << warmupRuns << " Pinned CPU: " << pinnedCpu
+            << " Performance Counters: "
+            << (threadPerfCounters().isAnyAvailable() ? "yes" : "no")
+            << std::endl;
+  runSummary.AddMember("WarmupRuns", warmupRuns, runSummary.GetAllocator());
+  runSummary.AddMember("PinnedCpu", pinnedCpu, runSummary.GetAllocator());
+
   std::unique_ptr<rans::SymbolStatistics> stats(nullptr);
   // read in or create dictionary
   if (dictPath.empty()) {
     // no dict path, create tokens.
-    stats = std::make_unique<rans::SymbolStatistics>(tokens, symbolRangeBits);
+    stats = std::make_unique<rans::SymbolStatistics>(tokens, symbolRangeBits,
+                                                     pool);
   } else {
     // open file
-    std::ifstream dictFile(dictPath);
-    json::IStreamWrapper dictReader(dictFile);
-    json::Document statsJSON;
-    statsJSON.ParseStream(dictReader);
-    stats = std::make_unique<rans::SymbolStatistics>(statsJSON.GetObject());
+    std::ifstream dictFile(dictPath, std::ios_base::binary);
+    char magic[sizeof(rans::BinaryDictionary::MAGIC)] = {};
+    dictFile.read(magic, sizeof(magic));
+    if (rans::BinaryDictionary::isBinaryDictionary(magic,
+                                                   dictFile.gcount())) {
+      // mappings are page aligned, the dictionary is used in place.
+      const rans::MappedFile dictBuffer(dictPath);
+      const rans::BinaryDictionaryView dict(dictBuffer.data(),
+                                            dictBuffer.size());
+      stats = std::make_unique<rans::SymbolStatistics>(
+          dict.getSymbolStatistics());
+    } else {
+      dictFile.clear();
+      dictFile.seekg(0);
+      json::IStreamWrapper dictReader(dictFile);
+      json::Document statsJSON;
+      statsJSON.ParseStream(dictReader);
+      stats = std::make_unique<rans::SymbolStatistics>(statsJSON.GetObject());
+    }
   }
 
   stats->rescaleFrequencyTable(prob_scale);
@@ -181,29 +308,32 @@ int main(int argc, char* argv[]) {
   runSummary.AddMember("SymbolRange", symbolRangeBits,
                        runSummary.GetAllocator());
 
-  const size_t out_max_size = 256 << 20;  // 256MB
-  const size_t out_max_elems = out_max_size / sizeof(stream_t);
-  std::vector<stream_t> out_buf(out_max_elems);
-  const stream_t* out_end = &out_buf.back();
+  // sized for the worst case of every coder writing into it: the
+  // non-interleaved, interleaved and 8 way SIMD layouts, at the probability
+  // bits of the dictionary or of the symbol adaptive model.
+  const size_t out_max_elems = [&]() {
+    const size_t bits =
+        std::max<size_t>(prob_bits, rans::AdaptiveCDF::PROBABILITY_BITS);
+    return std::max(
+        {rans::maxCompressedSize<coder_t, stream_t, 1>(tokens.size(), bits),
+         rans::maxCompressedSize<coder_t, stream_t, PARALLEL_LANES>(
+             tokens.size(), bits),
+         rans::maxCompressedSize<coder_t, stream_t, 8>(tokens.size(), bits)});
+  }();
+  rans::OutputBuffer<stream_t> out_buf(out_max_elems);
+  const stream_t* out_end = out_buf.end();
+  std::cout << "Output Buffer: " << out_max_elems * sizeof(stream_t)
+            << " Bytes" << std::endl;
   std::vector<source_t> dec_bytes(tokens.size(), 0xcc);
 
-  // cumlative->symbol table
-  // this is super brute force
-  std::vector<source_t> cum2sym(prob_scale);
-  // go over all symbols
-  for (int symbol = stats->minSymbol(); symbol < stats->maxSymbol() + 1;
-       symbol++)
-    for (uint32_t cumulative = (*stats)[symbol].second;
-         cumulative < (*stats)[symbol + 1].second; cumulative++) {
-      cum2sym[cumulative] = symbol;
-      //      std::cout << "cum2sym[" << cumulative << "]: " << symbol;
-    }
-
   stream_t* rans_begin = nullptr;
 
-  rans::SymbolTable<rans::EncoderSymbol<coder_t>> encoderSymbolTable(*stats,
-                                                                     prob_bits);
-  rans::SymbolTable<rans::DecoderSymbol> decoderSymbolTable(*stats, prob_bits);
+  // tables are shared through the cache, and with a cache directory only
+  // built on the first run with this dictionary.
+  rans::TableCache tableCache(cachePath);
+  const auto tables = tableCache.get<coder_t>(*stats, prob_bits);
+  const auto encoderSymbolTable = tables->getEncoderTable<coder_t>();
+  const rans::DecoderTableView decoderTable = tables->getDecoderTable();
 
   std::cout << "Source Size :"
             << static_cast<uint32_t>(std::ceil(1.0 * tokens.size() *
@@ -217,7 +347,7 @@ int main(int argc, char* argv[]) {
   nonInterleaved.AddMember(
       "Encode",
       timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
-               ExecutionMode::NonInterleaved, CodingMode::Encode, repetitions,
+               tokens.size(), CodingMode::Encode, repetitions,
                [&]() {
                  rans::State<coder_t> rans;
                  Rans::encInit(&rans);
@@ -243,26 +373,26 @@ int main(int argc, char* argv[]) {
   nonInterleaved.AddMember(
       "Decode",
       timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
-               ExecutionMode::NonInterleaved, CodingMode::Decode, repetitions,
+               tokens.size(), CodingMode::Decode, repetitions,
                [&]() {
-                 rans::State<coder_t> rans;
-                 stream_t* ptr = rans_begin;
-                 Rans::decInit(&rans, &ptr);
-
-                 for (size_t i = 0; i < tokens.size(); i++) {
-                   source_t s = cum2sym[Rans::decGet(&rans, prob_bits)];
-                   dec_bytes[i] = s;
-                   //            std::cout << "s: " << s << ", dsyms[" <<
-                   //            normalized << "]: " << dsyms[normalized].freq
-                   //            << std::endl;
-                   Rans::decAdvanceSymbol(&rans, &ptr, &decoderSymbolTable[s],
-                                          prob_bits);
-                 }
+                 decoderTable.visit([&](const auto& table) {
+                   rans::State<coder_t> rans;
+                   stream_t* ptr = rans_begin;
+                   Rans::decInit(&rans, &ptr);
+
+                   for (size_t i = 0; i < tokens.size(); i++) {
+                     const rans::DecoderTableEntry entry =
+                         table[Rans::decGet(&rans, prob_bits)];
+                     dec_bytes[i] = entry.symbol;
+                     Rans::decAdvance(&rans, &ptr, entry.start, entry.freq,
+                                      prob_bits);
+                   }
+                 });
                }),
       runSummary.GetAllocator());
 
-  unsigned int encodeSize =
-      static_cast<unsigned int>(&out_buf.back() - rans_begin) *
+  const unsigned int encodeSize =
+      static_cast<unsigned int>(out_end - rans_begin) *
       sizeof(stream_t);
   std::cout << "Encode Size :" << encodeSize << " Bytes" << std::endl;
   nonInterleaved.AddMember("Size", encodeSize, runSummary.GetAllocator());
@@ -279,93 +409,593 @@ int main(int argc, char* argv[]) {
 
   // ---- interleaved rANS encode/decode. This is the kind of thing you might do
   // to optimize critical paths.
+  json::Value interleaved(json::kObjectType);
+
+  auto runInterleaved = [&](auto lanes) {
+    constexpr size_t NLanes = decltype(lanes)::value;
+    const rans::Encoder<coder_t, stream_t, NLanes> encoder(*stats, prob_bits);
+    const rans::Decoder<coder_t, stream_t, NLanes> decoder(*stats, prob_bits);
+
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    std::cout << std::endl
+              << "Interleaved (" << NLanes << " states):" << std::endl;
+    json::Value lanesSummary(json::kObjectType);
+
+    lanesSummary.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   rans_begin = encoder.encode(
+                       tokens.begin(), tokens.end(), out_buf.begin(),
+                       const_cast<stream_t*>(out_end));
+                 }),
+        runSummary.GetAllocator());
+
+    lanesSummary.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() {
+                   decoder.decode(rans_begin, dec_bytes.begin(),
+                                  tokens.size());
+                 }),
+        runSummary.GetAllocator());
+
+    const unsigned int encodeSize =
+        static_cast<unsigned int>(out_end - rans_begin) *
+        sizeof(stream_t);
+    std::cout << "Encode Size :" << encodeSize << " Bytes" << std::endl;
+    lanesSummary.AddMember("Size", encodeSize, runSummary.GetAllocator());
+    interleaved.AddMember(
+        json::Value().SetString(std::to_string(NLanes).c_str(),
+                                runSummary.GetAllocator()),
+        lanesSummary, runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  };
+
+  runInterleaved(std::integral_constant<size_t, 2>{});
+  runInterleaved(std::integral_constant<size_t, 4>{});
+  runInterleaved(std::integral_constant<size_t, 8>{});
+  runInterleaved(std::integral_constant<size_t, 16>{});
+  runSummary.AddMember("Interleaved", interleaved, runSummary.GetAllocator());
+
+  // ---- interleaved rANS encode/decode through an alias table. Decoding needs
+  // memory proportional to the number of symbols instead of to the number of
+  // slots, which keeps large symbol ranges cache resident.
+  {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    std::cout << std::endl
+              << "Alias (" << PARALLEL_LANES << " states):" << std::endl;
+    json::Value alias(json::kObjectType);
+    const rans::AliasEncoder<coder_t, stream_t, PARALLEL_LANES> encoder(
+        *stats, prob_bits);
+    const rans::AliasDecoder<coder_t, stream_t, PARALLEL_LANES> decoder(
+        *stats, prob_bits);
+
+    alias.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   rans_begin = encoder.encode(
+                       tokens.begin(), tokens.end(), out_buf.begin(),
+                       const_cast<stream_t*>(out_end));
+                 }),
+        runSummary.GetAllocator());
+
+    alias.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() {
+                   decoder.decode(rans_begin, dec_bytes.begin(),
+                                  tokens.size());
+                 }),
+        runSummary.GetAllocator());
+
+    const unsigned int aliasEncodeSize =
+        static_cast<unsigned int>(out_end - rans_begin) *
+        sizeof(stream_t);
+    std::cout << "Encode Size :" << aliasEncodeSize << " Bytes" << std::endl;
+    alias.AddMember("Size", aliasEncodeSize, runSummary.GetAllocator());
+    runSummary.AddMember("Alias", alias, runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  }
+
+  // ---- sparse rANS encode/decode. Only the most frequent symbols are in the
+  // table, all others are escaped and stored as raw bits, so the table size
+  // does not depend on the range of the source data.
+  {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    // leave room for the escape symbol.
+    const size_t maxSymbols =
+        std::min(sparseSymbols, (static_cast<size_t>(1) << prob_bits) - 1);
+    std::cout << std::endl
+              << "Sparse (" << maxSymbols << " symbols):" << std::endl;
+    json::Value sparse(json::kObjectType);
+    rans::SparseSymbolStatistics sparseStats(tokens, maxSymbols);
+    sparseStats.rescaleFrequencyTable(prob_scale);
+    const rans::SparseEncoder<coder_t, stream_t, PARALLEL_LANES> encoder(
+        sparseStats, prob_bits);
+    const rans::SparseDecoder<coder_t, stream_t, PARALLEL_LANES> decoder(
+        sparseStats, prob_bits);
+    rans::EncodedSparse<stream_t> encodedSparse;
+
+    sparse.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   encodedSparse = encoder.encode(
+                       tokens.data(), tokens.data() + tokens.size());
+                 }),
+        runSummary.GetAllocator());
+
+    sparse.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() { decoder.decode(encodedSparse, dec_bytes.data()); }),
+        runSummary.GetAllocator());
+
+    const unsigned int sparseEncodeSize =
+        encodedSparse.stream.size() * sizeof(stream_t) +
+        encodedSparse.escapes.size() * sizeof(uint64_t);
+    std::cout << "Encode Size :" << sparseEncodeSize << " Bytes ("
+              << encodedSparse.numEscapes << " Escapes)" << std::endl;
+    sparse.AddMember("Size", sparseEncodeSize, runSummary.GetAllocator());
+    sparse.AddMember("Symbols", maxSymbols, runSummary.GetAllocator());
+    sparse.AddMember("Escapes", encodedSparse.numEscapes,
+                     runSummary.GetAllocator());
+    runSummary.AddMember("Sparse", sparse, runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  }
+
+  // ---- symbol adaptive rANS encode/decode. Small alphabets only, the model
+  // adapts after every symbol, so neither statistics nor a dictionary are
+  // needed.
+  if (stats->minSymbol() >= 0 &&
+      static_cast<size_t>(stats->maxSymbol()) <
+          rans::AdaptiveCDF::MAX_SYMBOLS) {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    const size_t numSymbols = std::max(stats->maxSymbol() + 1, 2);
+    std::cout << std::endl
+              << "Symbol Adaptive (" << numSymbols << " symbols):" << std::endl;
+    json::Value symbolAdaptive(json::kObjectType);
+    const rans::SymbolAdaptiveEncoder<coder_t, stream_t, PARALLEL_LANES>
+        encoder(numSymbols);
+    const rans::SymbolAdaptiveDecoder<coder_t, stream_t, PARALLEL_LANES>
+        decoder(numSymbols);
+
+    symbolAdaptive.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   rans_begin = encoder.encode(
+                       tokens.begin(), tokens.end(), out_buf.begin(),
+                       const_cast<stream_t*>(out_end));
+                 }),
+        runSummary.GetAllocator());
+
+    symbolAdaptive.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() {
+                   decoder.decode(rans_begin, dec_bytes.begin(),
+                                  tokens.size());
+                 }),
+        runSummary.GetAllocator());
+
+    const unsigned int symbolAdaptiveEncodeSize =
+        static_cast<unsigned int>(out_end - rans_begin) *
+        sizeof(stream_t);
+    std::cout << "Encode Size :" << symbolAdaptiveEncodeSize << " Bytes"
+              << std::endl;
+    symbolAdaptive.AddMember("Size", symbolAdaptiveEncodeSize,
+                             runSummary.GetAllocator());
+    runSummary.AddMember("SymbolAdaptive", symbolAdaptive,
+                         runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  }
+
+  // ---- order-1 context rANS encode/decode. The table of a symbol depends on
+  // its predecessor, the model has to be stored along with the stream.
+  if (static_cast<int64_t>(stats->maxSymbol()) - stats->minSymbol() <
+      static_cast<int64_t>(rans::ContextStatistics::MAX_SYMBOL_RANGE)) {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    const rans::ContextStatistics contextStats(tokens, prob_bits);
+    std::cout << std::endl
+              << "Context (" << contextStats.getNumTables() << " tables):"
+              << std::endl;
+    json::Value context(json::kObjectType);
+    const rans::ContextEncoder<coder_t, stream_t, PARALLEL_LANES> encoder(
+        contextStats);
+    const rans::ContextDecoder<coder_t, stream_t, PARALLEL_LANES> decoder(
+        contextStats);
+
+    context.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   rans_begin = encoder.encode(
+                       tokens.begin(), tokens.end(), out_buf.begin(),
+                       const_cast<stream_t*>(out_end));
+                 }),
+        runSummary.GetAllocator());
+
+    context.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() {
+                   decoder.decode(rans_begin, dec_bytes.begin(),
+                                  tokens.size());
+                 }),
+        runSummary.GetAllocator());
+
+    const unsigned int modelSize = contextStats.serialize().size();
+    const unsigned int contextEncodeSize =
+        static_cast<unsigned int>(out_end - rans_begin) *
+            sizeof(stream_t) +
+        modelSize;
+    std::cout << "Encode Size :" << contextEncodeSize << " Bytes ("
+              << modelSize << " Bytes Model)" << std::endl;
+    context.AddMember("Size", contextEncodeSize, runSummary.GetAllocator());
+    context.AddMember("ModelSize", modelSize, runSummary.GetAllocator());
+    context.AddMember(
+        "Tables", static_cast<unsigned int>(contextStats.getNumTables()),
+        runSummary.GetAllocator());
+    runSummary.AddMember("Context", context, runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  }
+
+  // ---- block parallel rANS encode/decode. Every block has its own states,
+  // blocks are spread over a pool of worker threads.
+  {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    std::cout << std::endl << "Parallel:" << std::endl;
+    json::Value parallel(json::kObjectType);
+    const rans::BlockEncoder<coder_t, stream_t, PARALLEL_LANES> blockEncoder(
+        *stats, prob_bits, blockSize);
+    const rans::BlockDecoder<coder_t, stream_t, PARALLEL_LANES> blockDecoder(
+        *stats, prob_bits);
+    rans::EncodedBlocks<stream_t> encodedBlocks;
+
+    parallel.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   encodedBlocks = blockEncoder.encode(
+                       tokens.data(), tokens.data() + tokens.size(), pool);
+                 }),
+        runSummary.GetAllocator());
+
+    parallel.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() {
+                   blockDecoder.decode(encodedBlocks, dec_bytes.data(), pool);
+                 }),
+        runSummary.GetAllocator());
+
+    const unsigned int parallelEncodeSize =
+        encodedBlocks.stream.size() * sizeof(stream_t) +
+        encodedBlocks.index.size() * sizeof(rans::BlockIndexEntry);
+    std::cout << "Encode Size :" << parallelEncodeSize << " Bytes ("
+              << encodedBlocks.index.size() << " Blocks)" << std::endl;
+    parallel.AddMember("Size", parallelEncodeSize, runSummary.GetAllocator());
+    parallel.AddMember("Threads", threads, runSummary.GetAllocator());
+    parallel.AddMember("BlockSize", blockSize, runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+
+    // pack everything into a self-describing frame and decode from it.
+    const std::vector<uint8_t> frameBuffer =
+        rans::Frame::serialize<coder_t, stream_t, PARALLEL_LANES, source_t>(
+            *stats, prob_bits, encodedBlocks);
+    std::cout << "Frame Size :" << frameBuffer.size() << " Bytes" << std::endl;
+    parallel.AddMember("FrameSize", frameBuffer.size(),
+                       runSummary.GetAllocator());
+    runSummary.AddMember("Parallel", parallel, runSummary.GetAllocator());
+
+    const rans::Frame frame(frameBuffer.data(), frameBuffer.size());
+    frame.checkCoder<coder_t, stream_t, PARALLEL_LANES, source_t>();
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+    rans::BlockDecoder<coder_t, stream_t, PARALLEL_LANES>(
+        frame.getSymbolStatistics(), frame.getHeader().probabilityBits)
+        .decode(frame.getPayload<stream_t>(), frame.getBlockIndex(),
+                dec_bytes.data(), pool);
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Frame decoder passed tests.\n");
+    else
+      printf("ERROR: Frame decoder failed tests.\n");
+
+    if (!framePath.empty()) {
+      std::ofstream frameFile(framePath, std::ios_base::binary);
+      frameFile.write(reinterpret_cast<const char*>(frameBuffer.data()),
+                      frameBuffer.size());
+    }
+  }
+
+  // ---- streaming rANS encode. The input is fed front to back in small
+  // pieces, the encoder only buffers one window of blockSize symbols. Chunks
+  // are collected as blocks, so they decode in parallel.
+  {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    std::cout << std::endl << "Streaming:" << std::endl;
+    json::Value streaming(json::kObjectType);
+    constexpr size_t PIECE_SIZE = 4096;
+    rans::EncodedBlocks<stream_t> chunks;
+    rans::StreamEncoder<coder_t, stream_t, PARALLEL_LANES, source_t>
+        streamEncoder(*stats, prob_bits, blockSize,
+                      [&](const stream_t* begin, const stream_t* end,
+                          size_t numSymbols) {
+                        chunks.index.push_back(
+                            {chunks.stream.size(),
+                             static_cast<uint64_t>(end - begin), numSymbols});
+                        chunks.stream.insert(chunks.stream.end(), begin, end);
+                      });
+    const rans::BlockDecoder<coder_t, stream_t, PARALLEL_LANES> blockDecoder(
+        *stats, prob_bits);
+
+    streaming.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   chunks.stream.clear();
+                   chunks.index.clear();
+                   for (size_t i = 0; i < tokens.size(); i += PIECE_SIZE) {
+                     const auto pieceBegin = tokens.begin() + i;
+                     streamEncoder.write(
+                         pieceBegin,
+                         pieceBegin + std::min(PIECE_SIZE, tokens.size() - i));
+                   }
+                   streamEncoder.flush();
+                 }),
+        runSummary.GetAllocator());
+
+    streaming.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() { blockDecoder.decode(chunks, dec_bytes.data(), pool); }),
+        runSummary.GetAllocator());
+
+    const unsigned int streamingEncodeSize =
+        chunks.stream.size() * sizeof(stream_t) +
+        chunks.index.size() * sizeof(rans::BlockIndexEntry);
+    std::cout << "Encode Size :" << streamingEncodeSize << " Bytes ("
+              << chunks.index.size() << " Chunks)" << std::endl;
+    streaming.AddMember("Size", streamingEncodeSize, runSummary.GetAllocator());
+    streaming.AddMember("WindowSize", blockSize, runSummary.GetAllocator());
+    runSummary.AddMember("Streaming", streaming, runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  }
+
+  // ---- multi column rANS encode/decode. The tokens are read as records of
+  // COLUMNS interleaved fields, every field is coded with its own dictionary.
+  {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    std::cout << std::endl << "Columns:" << std::endl;
+    json::Value columns(json::kObjectType);
+    constexpr size_t COLUMNS = 4;
+    const size_t numRecords = tokens.size() / COLUMNS;
+    const std::ptrdiff_t recordBytes = COLUMNS * sizeof(source_t);
+
+    std::vector<rans::StridedSpan<const source_t>> fields;
+    std::vector<rans::StridedSpan<source_t>> decodedFields;
+    rans::ColumnEncoder<coder_t, stream_t, PARALLEL_LANES> columnEncoder;
+    for (size_t column = 0; column < COLUMNS; column++) {
+      fields.emplace_back(tokens.data() + column, numRecords, recordBytes);
+      decodedFields.emplace_back(dec_bytes.data() + column, numRecords,
+                                 recordBytes);
+      rans::SymbolStatistics fieldStats(fields.back());
+      fieldStats.rescaleFrequencyTable(prob_scale);
+      columnEncoder.addColumn(fieldStats, prob_bits);
+    }
+    std::vector<uint8_t> frameBuffer;
+
+    columns.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(),
+                 symbolRangeBits * numRecords * COLUMNS, numRecords * COLUMNS,
+                 CodingMode::Encode, repetitions,
+                 [&]() {
+                   frameBuffer = columnEncoder.encode(
+                       pool, fields[0], fields[1], fields[2], fields[3]);
+                 }),
+        runSummary.GetAllocator());
+
+    const rans::ColumnFrame frame(frameBuffer.data(), frameBuffer.size());
+    const rans::ColumnDecoder<coder_t, stream_t, PARALLEL_LANES> columnDecoder(
+        frame);
+
+    columns.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(),
+                 symbolRangeBits * numRecords * COLUMNS, numRecords * COLUMNS,
+                 CodingMode::Decode, repetitions,
+                 [&]() {
+                   std::vector<std::future<void>> tasks;
+                   for (size_t column = 0; column < COLUMNS; column++) {
+                     tasks.push_back(pool.submit([&, column]() {
+                       columnDecoder.decode(column,
+                                            decodedFields[column].begin());
+                     }));
+                   }
+                   rans::waitAll(tasks);
+                 }),
+        runSummary.GetAllocator());
+
+    std::cout << "Frame Size :" << frameBuffer.size() << " Bytes ("
+              << COLUMNS << " Columns)" << std::endl;
+    columns.AddMember("FrameSize", frameBuffer.size(),
+                      runSummary.GetAllocator());
+    columns.AddMember("Columns", static_cast<unsigned int>(COLUMNS),
+                      runSummary.GetAllocator());
+    runSummary.AddMember("Columns", columns, runSummary.GetAllocator());
+
+    // check decode results, a partial last record is not coded.
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               numRecords * COLUMNS * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  }
+
+  // ---- block adaptive rANS encode/decode. Every block is coded with a table
+  // of its own, sent as an update of the table of the previous block.
+  {
+    memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
+
+    std::cout << std::endl << "Adaptive:" << std::endl;
+    json::Value adaptive(json::kObjectType);
+    const rans::AdaptiveBlockEncoder<coder_t, stream_t, PARALLEL_LANES>
+        adaptiveEncoder(prob_bits, blockSize);
+    const rans::AdaptiveBlockDecoder<coder_t, stream_t, PARALLEL_LANES>
+        adaptiveDecoder(prob_bits);
+    rans::EncodedAdaptiveBlocks<stream_t> encodedBlocks;
+
+    adaptive.AddMember(
+        "Encode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Encode, repetitions,
+                 [&]() {
+                   encodedBlocks = adaptiveEncoder.encode(
+                       tokens.data(), tokens.data() + tokens.size(), pool);
+                 }),
+        runSummary.GetAllocator());
+
+    adaptive.AddMember(
+        "Decode",
+        timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
+                 tokens.size(), CodingMode::Decode, repetitions,
+                 [&]() {
+                   adaptiveDecoder.decode(encodedBlocks, dec_bytes.data(),
+                                          pool);
+                 }),
+        runSummary.GetAllocator());
+
+    const unsigned int adaptiveEncodeSize =
+        encodedBlocks.blocks.stream.size() * sizeof(stream_t) +
+        encodedBlocks.blocks.index.size() * sizeof(rans::BlockIndexEntry) +
+        encodedBlocks.tableUpdates.size();
+    std::cout << "Encode Size :" << adaptiveEncodeSize << " Bytes ("
+              << encodedBlocks.tableUpdates.size() << " Bytes Tables)"
+              << std::endl;
+    adaptive.AddMember("Size", adaptiveEncodeSize, runSummary.GetAllocator());
+    adaptive.AddMember("TableSize", encodedBlocks.tableUpdates.size(),
+                       runSummary.GetAllocator());
+    adaptive.AddMember("BlockSize", blockSize, runSummary.GetAllocator());
+    runSummary.AddMember("Adaptive", adaptive, runSummary.GetAllocator());
+
+    // check decode results
+    if (memcmp(tokens.data(), dec_bytes.data(),
+               tokens.size() * sizeof(source_t)) == 0)
+      printf("Decoder passed tests.\n");
+    else
+      printf("ERROR: Decoder failed tests.\n");
+  }
+
+#ifdef ransWord
+  // ---- 8 way interleaved SIMD rANS encode/decode.
 
   memset(dec_bytes.data(), 0xcc, tokens.size() * sizeof(source_t));
 
-  // try interleaved rANS encode
-  std::cout << std::endl << "Interleaved:" << std::endl;
-  json::Value interleaved(json::kObjectType);
+  std::cout << std::endl
+            << "SIMD (" << rans::toString(simdLevel) << "):" << std::endl;
+  json::Value simd(json::kObjectType);
+  const rans::SIMDEncoder<source_t> simdEncoder(*stats, prob_bits, simdLevel);
+  const rans::SIMDDecoder<source_t> simdDecoder(*stats, prob_bits, simdLevel);
+  simd.AddMember("Level",
+                 json::Value().SetString(rans::toString(simdLevel).c_str(),
+                                         runSummary.GetAllocator()),
+                 runSummary.GetAllocator());
 
-  interleaved.AddMember(
+  simd.AddMember(
       "Encode",
       timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
-               ExecutionMode::Interleaved, CodingMode::Encode, repetitions,
+               tokens.size(), CodingMode::Encode, repetitions,
                [&]() {
-                 rans::State<coder_t> rans0, rans1;
-                 Rans::encInit(&rans0);
-                 Rans::encInit(&rans1);
-
-                 stream_t* ptr = const_cast<stream_t*>(out_end);
-
-                 // odd number of bytes?
-                 if (tokens.size() & 1) {
-                   const int s = tokens.back();
-                   Rans::encPutSymbol(&rans0, &ptr, &encoderSymbolTable[s],
-                                      prob_bits);
-                   //            Rans::encPut(&rans0, &ptr,
-                   //            stats->cum_freqs[normalized],
-                   //            stats->freqs[normalized], prob_bits);
-                 }
-
-                 for (size_t i = (tokens.size() & ~1); i > 0;
-                      i -= 2) {  // NB: working in reverse!
-                   const int s1 = tokens[i - 1];
-                   const int s0 = tokens[i - 2];
-                   Rans::encPutSymbol(&rans1, &ptr, &encoderSymbolTable[s1],
-                                      prob_bits);
-                   Rans::encPutSymbol(&rans0, &ptr, &encoderSymbolTable[s0],
-                                      prob_bits);
-                   //            Rans::encPut(&rans1, &ptr,
-                   //            stats->cum_freqs[normalized1],
-                   //            stats->freqs[normalized1], prob_bits);
-                   //            Rans::encPut(&rans0, &ptr,
-                   //            stats->cum_freqs[normalized0],
-                   //            stats->freqs[normalized0], prob_bits);
-                 }
-                 Rans::encFlush(&rans1, &ptr);
-                 Rans::encFlush(&rans0, &ptr);
-                 rans_begin = ptr;
+                 rans_begin = simdEncoder.encode(
+                     tokens.data(), tokens.data() + tokens.size(),
+                     out_buf.begin(), const_cast<stream_t*>(out_end));
                }),
       runSummary.GetAllocator());
 
-  interleaved.AddMember(
+  simd.AddMember(
       "Decode",
       timedRun(runSummary.GetAllocator(), symbolRangeBits * tokens.size(),
-               ExecutionMode::Interleaved, CodingMode::Decode, repetitions,
+               tokens.size(), CodingMode::Decode, repetitions,
                [&]() {
-                 rans::State<coder_t> rans0, rans1;
-                 stream_t* ptr = rans_begin;
-                 Rans::decInit(&rans0, &ptr);
-                 Rans::decInit(&rans1, &ptr);
-
-                 for (size_t i = 0; i < (tokens.size() & ~1); i += 2) {
-                   const uint32_t s0 = cum2sym[Rans::decGet(&rans0, prob_bits)];
-                   const uint32_t s1 = cum2sym[Rans::decGet(&rans1, prob_bits)];
-                   dec_bytes[i + 0] = s0;
-                   dec_bytes[i + 1] = s1;
-                   Rans::decAdvanceSymbolStep(&rans0, &decoderSymbolTable[s0],
-                                              prob_bits);
-                   Rans::decAdvanceSymbolStep(&rans1, &decoderSymbolTable[s1],
-                                              prob_bits);
-                   Rans::decRenorm(&rans0, &ptr);
-                   Rans::decRenorm(&rans1, &ptr);
-                 }
-
-                 // last byte, if number of bytes was odd
-                 if (tokens.size() & 1) {
-                   const uint32_t s0 = cum2sym[Rans::decGet(&rans0, prob_bits)];
-                   dec_bytes[tokens.size() - 1] = s0;
-                   Rans::decAdvanceSymbol(&rans0, &ptr, &decoderSymbolTable[s0],
-                                          prob_bits);
-                 }
+                 simdDecoder.decode(rans_begin, out_end, dec_bytes.data(),
+                                    tokens.size());
                }),
       runSummary.GetAllocator());
 
-  encodeSize = static_cast<unsigned int>(&out_buf.back() - rans_begin) *
-               sizeof(stream_t);
-  std::cout << "Encode Size :" << encodeSize << " Bytes" << std::endl;
-  interleaved.AddMember("Size", encodeSize, runSummary.GetAllocator());
-  runSummary.AddMember("Interleaved", interleaved, runSummary.GetAllocator());
+  const unsigned int simdEncodeSize =
+      static_cast<unsigned int>(out_end - rans_begin) *
+      sizeof(stream_t);
+  std::cout << "Encode Size :" << simdEncodeSize << " Bytes" << std::endl;
+  simd.AddMember("Size", simdEncodeSize, runSummary.GetAllocator());
+  runSummary.AddMember("SIMD", simd, runSummary.GetAllocator());
 
   // check decode results
   if (memcmp(tokens.data(), dec_bytes.data(),
@@ -373,6 +1003,7 @@ int main(int argc, char* argv[]) {
     printf("Decoder passed tests.\n");
   else
     printf("ERROR: Decoder failed tests.\n");
+#endif
 
   std::ofstream f(logPath);
   json::OStreamWrapper osw(f);
@@ -388,5 +1019,12 @@ int main(int argc, char* argv[]) {
     stats->serialize(d.GetAllocator()).Accept(writer);
   }
 
+  if (!exportBinaryDictPath.empty()) {
+    const std::vector<uint8_t> dict =
+        rans::BinaryDictionary::serialize<coder_t>(*stats, prob_bits);
+    std::ofstream f(exportBinaryDictPath, std::ios_base::binary);
+    f.write(reinterpret_cast<const char*>(dict.data()), dict.size());
+  }
+
   return 0;
 }
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rapidjson/document.h"
+#include "rapidjson/ostreamwrapper.h"
+#include "rapidjson/prettywriter.h"
+
+#include "docopt.h"
+
+#include "librans/rans.h"
+
+#include "libcommon/executionTimer.h"
+#include "libcommon/syntheticData.h"
+
+#include "ransSuite.h"
+
+// Runs every codec with every coder configuration over a matrix of synthetic
+// inputs and writes one row per measurement, to tell which configuration suits
+// which shape of data.
+namespace json = rapidjson;
+
+static const char USAGE[] =
+    R"(ransSuite.
+
+        Usage:
+          ransSuite [-s <samples>] [-d <names>] [-a <bits>] [-n <sizes>] [-b <bits>] [-w <lanes>] [-x <codecs>] [-t <threads>] [-k <blockSize>] [-r <seed>] [-u <runs>] [-p <cpu>] [-l <log>] [-c <csv>]
+          ransSuite (-h | --help)
+          ransSuite --version
+
+        Options:
+          -h --help                           Show this screen.
+          --version                           Show version.
+          -s <samples> --samples <samples>    How many times do we repeat the measurements [default: 5].
+          -d <names> --distributions <names>  Distributions of the source data [default: Uniform,Geometric,Zipf,Gaussian,NearIncompressible].
+          -a <bits> --alphabet <bits>         Alphabet sizes in bits [default: 4,8,12,16].
+          -n <sizes> --sizes <sizes>          Symbols per input [default: 65536,4194304].
+          -b <bits> --bits <bits>             Probability bits of the dictionaries [default: 12,14,16,20].
+          -w <lanes> --lanes <lanes>          Interleaved states, out of 1,2,4,8,16 [default: 1,4,8].
+          -x <codecs> --codecs <codecs>       Codecs [default: Interleaved,Alias,Sparse,SymbolAdaptive,Context,Parallel,Adaptive,SIMD].
+          -t <threads> --threads <threads>    Worker threads for block parallel coding.
+          -k <size> --blocksize <size>        Symbols per block for block parallel coding [default: 1048576].
+          -r <seed> --seed <seed>             Seed of the generator [default: 42].
+          -u <runs> --warmup <runs>           Untimed runs before the measurements [default: 1].
+          -p <cpu> --pin <cpu>                Pin the timed thread to a CPU.
+          -l <log> --log <log>                Results in JSON format [default: suite.json].
+          -c <csv> --csv <csv>                Results in CSV format [default: suite.csv].
+
+    )";
+
+std::vector<std::string> split(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+template <typename T>
+std::vector<T> splitNumbers(const std::string& list) {
+  std::vector<T> numbers;
+  for (const auto& item : split(list)) {
+    numbers.push_back(static_cast<T>(std::stoull(item)));
+  }
+  return numbers;
+}
+
+template <size_t... N>
+bool isLaneWidth(size_t lanes, std::index_sequence<N...>) {
+  return (... || (lanes == N));
+}
+
+// All coder configurations on symbols, stored in the smallest source type
+// holding the alphabet.
+template <typename source_T>
+void runSource(const Options& options, const Point& point,
+               const std::vector<uint32_t>& symbols, rans::ThreadPool& pool,
+               std::vector<Row>& rows) {
+  const std::vector<source_T> tokens(symbols.begin(), symbols.end());
+  const rans::SymbolStatistics counts(tokens, 0, pool);
+
+  // the configurations of the rans32, ransWord and default ransBenchmark.
+  runCoder<uint32_t, uint8_t>("rans32", options, point, tokens, counts, pool,
+                              rows);
+  runCoder<uint32_t, uint16_t>("ransWord", options, point, tokens, counts,
+                               pool, rows);
+  runCoder<uint64_t, uint32_t>("rans64", options, point, tokens, counts, pool,
+                               rows);
+}
+
+void writeJSON(const std::string& path, const std::vector<Row>& rows,
+               uint64_t seed, size_t repetitions) {
+  json::Document summary;
+  summary.SetObject();
+  auto& allocator = summary.GetAllocator();
+  summary.AddMember("Seed", seed, allocator);
+  summary.AddMember("Repetitions", repetitions, allocator);
+
+  auto string = [&](const std::string& value) {
+    json::Value string;
+    string.SetString(value.c_str(), allocator);
+    return string;
+  };
+  json::Value results(json::kArrayType);
+  for (const auto& row : rows) {
+    json::Value result(json::kObjectType);
+    result.AddMember("Distribution", string(row.point.distribution),
+                     allocator);
+    result.AddMember("AlphabetBits", row.point.alphabetBits, allocator);
+    result.AddMember("NumberOfSymbols", row.point.numSymbols, allocator);
+    result.AddMember("Entropy", row.point.entropy, allocator);
+    result.AddMember("ProbabilityBits", row.probabilityBits, allocator);
+    result.AddMember("Coder", string(row.coder), allocator);
+    result.AddMember("Codec", string(row.codec), allocator);
+    result.AddMember("Lanes", row.lanes, allocator);
+    result.AddMember("Size", row.size, allocator);
+    result.AddMember("BitsPerSymbol", 8.0 * row.size / row.point.numSymbols,
+                     allocator);
+    result.AddMember("Encode", row.encodeBandwidth, allocator);
+    result.AddMember("EncodeMedian", row.encodeMedianBandwidth, allocator);
+    result.AddMember("EncodeCyclesPerSymbol", row.encodeCyclesPerSymbol,
+                     allocator);
+    result.AddMember("Decode", row.decodeBandwidth, allocator);
+    result.AddMember("DecodeMedian", row.decodeMedianBandwidth, allocator);
+    result.AddMember("DecodeCyclesPerSymbol", row.decodeCyclesPerSymbol,
+                     allocator);
+    result.AddMember("Passed", row.passed, allocator);
+    results.PushBack(result, allocator);
+  }
+  summary.AddMember("Results", results, allocator);
+
+  std::ofstream f(path);
+  json::OStreamWrapper osw(f);
+  json::PrettyWriter<json::OStreamWrapper> writer(osw);
+  summary.Accept(writer);
+}
+
+void writeCSV(const std::string& path, const std::vector<Row>& rows) {
+  std::ofstream f(path);
+  f << "Distribution,AlphabetBits,NumberOfSymbols,Entropy,ProbabilityBits,"
+       "Coder,Codec,Lanes,Size,BitsPerSymbol,Encode,EncodeMedian,"
+       "EncodeCyclesPerSymbol,Decode,DecodeMedian,DecodeCyclesPerSymbol,"
+       "Passed\n";
+  f << std::setprecision(6);
+  for (const auto& row : rows) {
+    f << row.point.distribution << ',' << row.point.alphabetBits << ','
+      << row.point.numSymbols << ',' << row.point.entropy << ','
+      << row.probabilityBits << ',' << row.coder << ',' << row.codec << ','
+      << row.lanes << ',' << row.size << ','
+      << 8.0 * row.size / row.point.numSymbols << ',' << row.encodeBandwidth
+      << ',' << row.encodeMedianBandwidth << ','
+      << row.encodeCyclesPerSymbol << ',' << row.decodeBandwidth << ','
+      << row.decodeMedianBandwidth << ',' << row.decodeCyclesPerSymbol << ','
+      << row.passed << '\n';
+  }
+}
+
+int main(int argc, char* argv[]) {
+  auto args =
+      docopt::docopt(USAGE, {argv + 1, argv + argc}, true, "ransSuite-dev");
+
+  Options options;
+  options.repetitions = static_cast<size_t>(args["--samples"].asLong());
+  options.probabilityBits =
+      splitNumbers<uint32_t>(args["--bits"].asString());
+  options.lanes = splitNumbers<size_t>(args["--lanes"].asString());
+  options.codecs = split(args["--codecs"].asString());
+  options.blockSize = static_cast<size_t>(args["--blocksize"].asLong());
+  const std::vector<size_t> alphabetBits =
+      splitNumbers<size_t>(args["--alphabet"].asString());
+  const std::vector<size_t> sizes =
+      splitNumbers<size_t>(args["--sizes"].asString());
+  const uint64_t seed = std::stoull(args["--seed"].asString());
+  const std::string logPath = args["--log"].asString();
+  const std::string csvPath = args["--csv"].asString();
+
+  std::vector<Distribution> distributions;
+  for (const auto& name : split(args["--distributions"].asString())) {
+    distributions.push_back(distributionFromString(name));
+  }
+
+  const uint32_t threads = [&]() {
+    try {
+      return static_cast<uint32_t>(args["--threads"].asLong());
+    } catch (std::runtime_error& e) {
+      return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+  }();
+
+  if (options.repetitions == 0 || options.probabilityBits.empty()) {
+    throw std::runtime_error("nothing to measure");
+  }
+  for (const size_t lanes : options.lanes) {
+    if (!isLaneWidth(lanes, LaneWidths{})) {
+      throw std::runtime_error("unsupported number of lanes " +
+                               std::to_string(lanes));
+    }
+  }
+
+  rans::ThreadPool pool(threads);
+  std::vector<Row> rows;
+
+  // pinned after the workers are started, which keep all CPUs.
+  timerSettings().warmupRuns = static_cast<size_t>(args["--warmup"].asLong());
+  if (args["--pin"].isString() &&
+      !pinToCpu(static_cast<int>(args["--pin"].asLong()))) {
+    std::cout << "WARNING: can not pin to CPU " << args["--pin"].asString()
+              << std::endl;
+  }
+
+  for (const Distribution distribution : distributions) {
+    for (const size_t bits : alphabetBits) {
+      for (const size_t numSymbols : sizes) {
+        const std::vector<uint32_t> symbols =
+            generateSymbols(distribution, bits, numSymbols, seed);
+        const Point point{toString(distribution), bits, numSymbols,
+                          entropy(symbols)};
+        std::cout << std::endl
+                  << point.distribution << ": " << bits << " Bit alphabet, "
+                  << numSymbols << " symbols, entropy "
+                  << std::setprecision(4) << point.entropy << " bits/symbol"
+                  << std::endl;
+
+        if (bits <= 8) {
+          runSource<uint8_t>(options, point, symbols, pool, rows);
+        } else if (bits <= 16) {
+          runSource<uint16_t>(options, point, symbols, pool, rows);
+        } else {
+          runSource<uint32_t>(options, point, symbols, pool, rows);
+        }
+      }
+    }
+  }
+
+  writeJSON(logPath, rows, seed, options.repetitions);
+  writeCSV(csvPath, rows);
+
+  const size_t failed = std::count_if(
+      rows.begin(), rows.end(), [](const Row& row) { return !row.passed; });
+  std::cout << std::endl
+            << rows.size() << " measurements, " << failed << " failed"
+            << std::endl;
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/*
+ * ransSuite.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "librans/rans.h"
+
+// interleave widths the codecs are instantiated for.
+using LaneWidths = std::index_sequence<1, 2, 4, 8, 16>;
+
+struct Options {
+  size_t repetitions;
+  std::vector<uint32_t> probabilityBits;
+  std::vector<size_t> lanes;
+  std::vector<std::string> codecs;
+  size_t blockSize;
+};
+
+// The input of a set of measurements.
+struct Point {
+  std::string distribution;
+  size_t alphabetBits;
+  size_t numSymbols;
+  double entropy;  // bits per symbol
+};
+
+struct Row {
+  Point point;
+  uint32_t probabilityBits;
+  std::string coder;
+  std::string codec;
+  size_t lanes;
+  // compressed bytes plus what a decoder needs besides the stream: the
+  // serialized dictionary, context model or table updates and block index.
+  size_t size;
+  // MiB/s of the source in the best and the median run.
+  double encodeBandwidth;
+  double encodeMedianBandwidth;
+  double decodeBandwidth;
+  double decodeMedianBandwidth;
+  // median clocks per symbol, 0 without a time stamp counter.
+  double encodeCyclesPerSymbol;
+  double decodeCyclesPerSymbol;
+  bool passed;
+};
+
+// All codecs of one coder configuration on tokens. Defined in
+// ransSuiteCoder.h and instantiated for every source type in one translation
+// unit per coder configuration, ransSuite32.cpp, ransSuiteWord.cpp and
+// ransSuite64.cpp, so they compile in parallel.
+template <typename coder_T, typename stream_T, typename source_T>
+void runCoder(const std::string& coder, const Options& options,
+              const Point& point, const std::vector<source_T>& tokens,
+              const rans::SymbolStatistics& counts, rans::ThreadPool& pool,
+              std::vector<Row>& rows);
@@ -0,0 +1,12 @@
+/*
+ * ransSuite32.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ransSuiteCoder.h"
+
+// runCoder in the configuration of rans32, for every source type.
+RANS_SUITE_INSTANTIATE(uint32_t, uint8_t, uint8_t);
+RANS_SUITE_INSTANTIATE(uint32_t, uint8_t, uint16_t);
+RANS_SUITE_INSTANTIATE(uint32_t, uint8_t, uint32_t);
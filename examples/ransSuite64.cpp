@@ -0,0 +1,12 @@
+/*
+ * ransSuite64.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ransSuiteCoder.h"
+
+// runCoder in the configuration of rans64, for every source type.
+RANS_SUITE_INSTANTIATE(uint64_t, uint32_t, uint8_t);
+RANS_SUITE_INSTANTIATE(uint64_t, uint32_t, uint16_t);
+RANS_SUITE_INSTANTIATE(uint64_t, uint32_t, uint32_t);
@@ -0,0 +1,333 @@
+/*
+ * ransSuiteCoder.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "librans/rans.h"
+
+#include "libcommon/executionTimer.h"
+
+#include "ransSuite.h"
+
+// Bytes of stats as stored in a frame, see rans::writeDictionary.
+inline size_t dictionarySize(const rans::SymbolStatistics& stats) {
+  std::vector<uint8_t> dictionary;
+  rans::ByteWriter writer(dictionary);
+  rans::writeDictionary(writer, stats);
+  return dictionary.size();
+}
+
+inline bool contains(const std::vector<std::string>& list,
+                     const std::string& item) {
+  return std::find(list.begin(), list.end(), item) != list.end();
+}
+
+// Calls f(std::integral_constant<size_t, N>) for every selected N of LaneWidths.
+template <typename F, size_t... N>
+void forEachLanes(const std::vector<size_t>& lanes, F&& f,
+                  std::index_sequence<N...>) {
+  (...,
+   (std::find(lanes.begin(), lanes.end(), N) != lanes.end()
+        ? f(std::integral_constant<size_t, N>{})
+        : void()));
+}
+
+template <typename F>
+void forEachLanes(const std::vector<size_t>& lanes, F&& f) {
+  forEachLanes(lanes, std::forward<F>(f), LaneWidths{});
+}
+
+// Times encode, which returns the compressed size in bytes, and decode,
+// which writes to decoded, and records the statistics of the repetitions.
+template <typename source_T, typename Encode, typename Decode>
+void measure(const Options& options, const Point& point,
+             uint32_t probabilityBits, const std::string& coder,
+             const std::string& codec, size_t lanes,
+             const std::vector<source_T>& tokens,
+             std::vector<source_T>& decoded, std::vector<Row>& rows,
+             Encode&& encode, Decode&& decode) {
+  size_t size = 0;
+  const std::vector<RunMeasurement> encodeRuns =
+      measureRuns(options.repetitions, [&]() { size = encode(); });
+  std::memset(decoded.data(), 0xcc, decoded.size() * sizeof(source_T));
+  const std::vector<RunMeasurement> decodeRuns =
+      measureRuns(options.repetitions, decode);
+
+  const double sourceBits =
+      static_cast<double>(point.alphabetBits) * point.numSymbols;
+  auto summarize = [&](const std::vector<RunMeasurement>& runs) {
+    std::vector<double> times;
+    std::vector<double> cycles;
+    for (const auto& run : runs) {
+      times.push_back(run.seconds);
+      cycles.push_back(static_cast<double>(run.timestampCycles) /
+                       std::max<size_t>(point.numSymbols, 1));
+    }
+    const RunStatistics time = runStatistics(times);
+    return std::make_tuple(sourceBits / (time.min * MIB_TO_BITS),
+                           sourceBits / (time.median * MIB_TO_BITS),
+                           runStatistics(cycles).median);
+  };
+  const auto [encodeBandwidth, encodeMedianBandwidth, encodeCycles] =
+      summarize(encodeRuns);
+  const auto [decodeBandwidth, decodeMedianBandwidth, decodeCycles] =
+      summarize(decodeRuns);
+
+  Row row{point,
+          probabilityBits,
+          coder,
+          codec,
+          lanes,
+          size,
+          encodeBandwidth,
+          encodeMedianBandwidth,
+          decodeBandwidth,
+          decodeMedianBandwidth,
+          encodeCycles,
+          decodeCycles,
+          std::memcmp(tokens.data(), decoded.data(),
+                      tokens.size() * sizeof(source_T)) == 0};
+
+  std::cout << std::left << std::setw(9) << coder << std::setw(15) << row.codec
+            << std::right << std::setw(3) << lanes << " lanes: "
+            << std::setprecision(4) << std::setw(8) << row.encodeBandwidth
+            << " / " << std::setw(8) << row.decodeBandwidth << " MiB/s, "
+            << std::setw(6) << row.encodeCyclesPerSymbol << " / "
+            << std::setw(6) << row.decodeCyclesPerSymbol << " clocks/symbol, "
+            << std::setw(6) << 8.0 * size / point.numSymbols << " bits/symbol"
+            << (row.passed ? "" : " ERROR: decoder failed tests") << std::endl;
+  rows.push_back(std::move(row));
+}
+
+template <typename coder_T, typename stream_T, typename source_T>
+void runCoder(const std::string& coder, const Options& options,
+              const Point& point, const std::vector<source_T>& tokens,
+              const rans::SymbolStatistics& counts, rans::ThreadPool& pool,
+              std::vector<Row>& rows) {
+  using Rans = rans::Coder<coder_T, stream_T>;
+  const size_t numSymbols = tokens.size();
+  std::vector<source_T> decoded(numSymbols);
+
+  const uint32_t maxBits = std::max(
+      *std::max_element(options.probabilityBits.begin(),
+                        options.probabilityBits.end()),
+      rans::AdaptiveCDF::PROBABILITY_BITS);
+  rans::OutputBuffer<stream_T> buffer;
+  forEachLanes(options.lanes, [&](auto lanes) {
+    constexpr size_t N = decltype(lanes)::value;
+    buffer.reserve(
+        rans::maxCompressedSize<coder_T, stream_T, N>(numSymbols, maxBits));
+  });
+  buffer.reserve(
+      rans::maxCompressedSize<coder_T, stream_T, 8>(numSymbols, maxBits));
+  stream_T* streamBegin = nullptr;
+  const auto streamBytes = [&]() {
+    return (buffer.end() - streamBegin) * sizeof(stream_T);
+  };
+
+  auto run = [&](uint32_t probabilityBits, ExecutionMode codec, size_t lanes,
+                 auto&& encode, auto&& decode) {
+    measure(options, point, probabilityBits, coder, toString(codec), lanes,
+            tokens, decoded, rows, encode, decode);
+  };
+  auto selected = [&](ExecutionMode codec) {
+    return contains(options.codecs, toString(codec));
+  };
+
+  for (const uint32_t probabilityBits : options.probabilityBits) {
+    if (probabilityBits > Rans::maxScaleBits() ||
+        point.alphabetBits > probabilityBits) {
+      continue;
+    }
+    rans::SymbolStatistics stats = counts;
+    stats.rescaleFrequencyTable(1u << probabilityBits);
+    // the alias tables are rebuilt from the same dictionary.
+    const size_t dictionaryBytes = dictionarySize(stats);
+
+    forEachLanes(options.lanes, [&](auto lanes) {
+      constexpr size_t N = decltype(lanes)::value;
+
+      if (selected(ExecutionMode::Interleaved)) {
+        const rans::Encoder<coder_T, stream_T, N> encoder(stats,
+                                                          probabilityBits);
+        const rans::Decoder<coder_T, stream_T, N> decoder(stats,
+                                                          probabilityBits);
+        run(probabilityBits, ExecutionMode::Interleaved, N,
+            [&]() {
+              streamBegin = encoder.encode(tokens.begin(), tokens.end(),
+                                           buffer.begin(), buffer.end());
+              return streamBytes() + dictionaryBytes;
+            },
+            [&]() {
+              decoder.decode(streamBegin, decoded.begin(), numSymbols);
+            });
+      }
+
+      if (selected(ExecutionMode::Alias)) {
+        const rans::AliasEncoder<coder_T, stream_T, N> encoder(
+            stats, probabilityBits);
+        const rans::AliasDecoder<coder_T, stream_T, N> decoder(
+            stats, probabilityBits);
+        run(probabilityBits, ExecutionMode::Alias, N,
+            [&]() {
+              streamBegin = encoder.encode(tokens.begin(), tokens.end(),
+                                           buffer.begin(), buffer.end());
+              return streamBytes() + dictionaryBytes;
+            },
+            [&]() {
+              decoder.decode(streamBegin, decoded.begin(), numSymbols);
+            });
+      }
+
+      if (selected(ExecutionMode::Sparse)) {
+        // leave room for the escape symbol.
+        const size_t maxSymbols =
+            std::min<size_t>(1 << 10, (size_t(1) << probabilityBits) - 1);
+        rans::SparseSymbolStatistics sparseStats(tokens, maxSymbols);
+        sparseStats.rescaleFrequencyTable(1u << probabilityBits);
+        const rans::SparseEncoder<coder_T, stream_T, N> encoder(
+            sparseStats, probabilityBits);
+        const rans::SparseDecoder<coder_T, stream_T, N> decoder(
+            sparseStats, probabilityBits);
+        // the index dictionary and the value of every index.
+        const size_t tableBytes =
+            dictionarySize(sparseStats.getIndexStatistics()) +
+            sparseStats.getEscapeIndex() * sizeof(int64_t);
+        rans::EncodedSparse<stream_T> encoded;
+        run(probabilityBits, ExecutionMode::Sparse, N,
+            [&]() {
+              encoded = encoder.encode(tokens.data(),
+                                       tokens.data() + tokens.size());
+              return encoded.stream.size() * sizeof(stream_T) +
+                     encoded.escapes.size() * sizeof(uint64_t) + tableBytes;
+            },
+            [&]() { decoder.decode(encoded, decoded.data()); });
+      }
+
+      if (selected(ExecutionMode::Context) &&
+          static_cast<int64_t>(stats.maxSymbol()) - stats.minSymbol() <
+              static_cast<int64_t>(rans::ContextStatistics::MAX_SYMBOL_RANGE)) {
+        const rans::ContextStatistics contextStats(tokens, probabilityBits);
+        const rans::ContextEncoder<coder_T, stream_T, N> encoder(contextStats);
+        const rans::ContextDecoder<coder_T, stream_T, N> decoder(contextStats);
+        const size_t modelSize = contextStats.serialize().size();
+        run(probabilityBits, ExecutionMode::Context, N,
+            [&]() {
+              streamBegin = encoder.encode(tokens.begin(), tokens.end(),
+                                           buffer.begin(), buffer.end());
+              return streamBytes() + modelSize;
+            },
+            [&]() {
+              decoder.decode(streamBegin, decoded.begin(), numSymbols);
+            });
+      }
+
+      if (selected(ExecutionMode::Parallel)) {
+        const rans::BlockEncoder<coder_T, stream_T, N> encoder(
+            stats, probabilityBits, options.blockSize);
+        const rans::BlockDecoder<coder_T, stream_T, N> decoder(
+            stats, probabilityBits);
+        rans::EncodedBlocks<stream_T> encoded;
+        run(probabilityBits, ExecutionMode::Parallel, N,
+            [&]() {
+              encoded = encoder.encode(tokens.begin(), tokens.end(), pool);
+              return encoded.stream.size() * sizeof(stream_T) +
+                     encoded.index.size() * sizeof(rans::BlockIndexEntry) +
+                     dictionaryBytes;
+            },
+            [&]() { decoder.decode(encoded, decoded.begin(), pool); });
+      }
+
+      if (selected(ExecutionMode::Adaptive)) {
+        const rans::AdaptiveBlockEncoder<coder_T, stream_T, N> encoder(
+            probabilityBits, options.blockSize);
+        const rans::AdaptiveBlockDecoder<coder_T, stream_T, N> decoder(
+            probabilityBits);
+        rans::EncodedAdaptiveBlocks<stream_T> encoded;
+        run(probabilityBits, ExecutionMode::Adaptive, N,
+            [&]() {
+              encoded = encoder.encode(tokens.begin(), tokens.end(), pool);
+              return encoded.blocks.stream.size() * sizeof(stream_T) +
+                     encoded.blocks.index.size() *
+                         sizeof(rans::BlockIndexEntry) +
+                     encoded.tableUpdates.size();
+            },
+            [&]() { decoder.decode(encoded, decoded.begin(), pool); });
+      }
+    });
+
+    if constexpr (std::is_same_v<coder_T, uint32_t> &&
+                  std::is_same_v<stream_T, uint16_t>) {
+      if (selected(ExecutionMode::SIMD) &&
+          std::find(options.lanes.begin(), options.lanes.end(),
+                    rans::SIMDEncoder<source_T>::NLANES) !=
+              options.lanes.end()) {
+        // every kernel the machine supports, they share the stream layout.
+        for (const rans::SIMDLevel level : rans::supportedSIMDLevels()) {
+          const rans::SIMDEncoder<source_T> encoder(stats, probabilityBits,
+                                                    level);
+          const rans::SIMDDecoder<source_T> decoder(stats, probabilityBits,
+                                                    level);
+          measure(
+              options, point, probabilityBits, coder,
+              toString(ExecutionMode::SIMD) + "/" + rans::toString(level),
+              rans::SIMDEncoder<source_T>::NLANES, tokens, decoded, rows,
+              [&]() {
+                streamBegin = encoder.encode(tokens.data(),
+                                             tokens.data() + tokens.size(),
+                                             buffer.begin(), buffer.end());
+                return streamBytes() + dictionaryBytes;
+              },
+              [&]() {
+                decoder.decode(streamBegin, buffer.end(), decoded.data(),
+                               numSymbols);
+              });
+        }
+      }
+    }
+  }
+
+  // the symbol adaptive model has fixed probability bits and no dictionary.
+  if (selected(ExecutionMode::SymbolAdaptive) && counts.minSymbol() >= 0 &&
+      static_cast<size_t>(counts.maxSymbol()) <
+          rans::AdaptiveCDF::MAX_SYMBOLS) {
+    const size_t alphabetSize = std::max(counts.maxSymbol() + 1, 2);
+    forEachLanes(options.lanes, [&](auto lanes) {
+      constexpr size_t N = decltype(lanes)::value;
+      const rans::SymbolAdaptiveEncoder<coder_T, stream_T, N> encoder(
+          alphabetSize);
+      const rans::SymbolAdaptiveDecoder<coder_T, stream_T, N> decoder(
+          alphabetSize);
+      run(rans::AdaptiveCDF::PROBABILITY_BITS, ExecutionMode::SymbolAdaptive,
+          N,
+          [&]() {
+            streamBegin = encoder.encode(tokens.begin(), tokens.end(),
+                                         buffer.begin(), buffer.end());
+            return streamBytes();
+          },
+          [&]() {
+            decoder.decode(streamBegin, decoded.begin(), numSymbols);
+          });
+    });
+  }
+}
+
+// Explicit instantiation of runCoder, see ransSuite32.cpp.
+#define RANS_SUITE_INSTANTIATE(coder_T, stream_T, source_T)                 \
+  template void runCoder<coder_T, stream_T, source_T>(                       \
+      const std::string& coder, const Options& options, const Point& point,  \
+      const std::vector<source_T>& tokens,                                   \
+      const rans::SymbolStatistics& counts, rans::ThreadPool& pool,          \
+      std::vector<Row>& rows)
@@ -0,0 +1,12 @@
+/*
+ * ransSuiteWord.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ransSuiteCoder.h"
+
+// runCoder in the configuration of ransWord, for every source type.
+RANS_SUITE_INSTANTIATE(uint32_t, uint16_t, uint8_t);
+RANS_SUITE_INSTANTIATE(uint32_t, uint16_t, uint16_t);
+RANS_SUITE_INSTANTIATE(uint32_t, uint16_t, uint32_t);
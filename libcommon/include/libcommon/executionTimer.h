@@ -11,13 +11,28 @@
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "rapidjson/document.h"
 namespace json = rapidjson;
 
 #include "definitions.h"
+#include "perfCounters.h"
 
-enum class ExecutionMode { NonInterleaved, Interleaved };
+enum class ExecutionMode {
+  NonInterleaved,
+  Interleaved,
+  Alias,
+  Sparse,
+  SymbolAdaptive,
+  Context,
+  SIMD,
+  Parallel,
+  Streaming,
+  Adaptive,
+  Columns
+};
 enum class CodingMode { Encode, Decode };
 
 std::string toString(ExecutionMode mode);
@@ -33,33 +48,74 @@ auto executionTimer(Decorated&& function) {
   return std::chrono::duration<double>(t1 - t0);
 }
 
-template <typename Decorated>
-json::Value timedRun(json::Document::AllocatorType& runSummaryAllocator,
-                     size_t sizeUncompressed, ExecutionMode executionMode,
-                     CodingMode codingMode, size_t numberOfRuns,
-                     Decorated&& function) {
-  const std::string execModeStr = toString(executionMode);
-  const std::string codingModeStr = toString(codingMode);
+// Settings shared by all timed runs.
+struct TimerSettings {
+  size_t warmupRuns = 1;  // untimed runs before the measurements
+};
+
+TimerSettings& timerSettings();
 
-  json::Value bandwidths(json::kArrayType);
-  std::cout << "Bandwidth " << codingModeStr << ": [";
+// A single timed run.
+struct RunMeasurement {
+  double seconds;
+  uint64_t timestampCycles;  // 0 without a time stamp counter
+  PerfCounters::Values counters;
+};
 
-  // run benchmark a certain amount of times
+// Smallest value, median and 99th percentile (nearest rank) over runs.
+struct RunStatistics {
+  double min;
+  double median;
+  double p99;
+};
+
+RunStatistics runStatistics(std::vector<double> values);
+
+// Runs function timerSettings().warmupRuns times untimed, then measures
+// numberOfRuns runs of it with wall clock, time stamp counter and the
+// performance counters of the calling thread.
+template <typename Decorated>
+std::vector<RunMeasurement> measureRuns(size_t numberOfRuns,
+                                        Decorated&& function) {
+  for (size_t run = 0; run < timerSettings().warmupRuns; run++) {
+    function();
+  }
+
+  PerfCounters& counters = threadPerfCounters();
+  std::vector<RunMeasurement> runs;
+  runs.reserve(numberOfRuns);
   for (size_t run = 0; run < numberOfRuns; run++) {
-    auto duration = executionTimer(function);
-    //		results.push_back(1.0 * (runSummary["NumberOfSymbols"].GetUint()
-    //* runSummary["SymbolRange"].GetUint())/ (duration.count() * BIT_TO_MIB));
-    ////Bit -> MiB
-
-    const auto time = duration.count();
-    const double bandwidth =
-        static_cast<double>(sizeUncompressed) / (time * MIB_TO_BITS);
-    bandwidths.PushBack(bandwidth, runSummaryAllocator);
-    std::cout << std::setprecision(4) << bandwidth;
-    if (run < numberOfRuns - 1) {
-      std::cout << ", ";
-    }
+    counters.start();
+    const uint64_t tsc0 = readTimestampCounter();
+    const auto duration = executionTimer(function);
+    const uint64_t tsc1 = readTimestampCounter();
+    const PerfCounters::Values values = counters.stop();
+    runs.push_back({duration.count(), tsc1 - tsc0, values});
   }
-  std::cout << "] MiB/s" << std::endl;
-  return std::move(bandwidths);
+  return runs;
+}
+
+// Prints runs and summarizes them as
+//   {"Bandwidths": [MiB/s of every run],
+//    "Time": {"Min", "Median", "P99"} in seconds,
+//    "Bandwidth": {"Max", "Median", "P99"} in MiB/s at those times,
+//    "CyclesPerSymbol": {"Min", "Median", "P99"} of the time stamp counter,
+//    "Counters": {<counter>: median per symbol, "InstructionsPerCycle"}}
+// where entries without a source on this machine are left out.
+json::Value summarizeRuns(json::Document::AllocatorType& runSummaryAllocator,
+                          size_t sizeUncompressed, size_t numSymbols,
+                          CodingMode codingMode,
+                          const std::vector<RunMeasurement>& runs);
+
+// Measures numberOfRuns runs of function coding numSymbols symbols of
+// sizeUncompressed bits in total, see measureRuns and summarizeRuns.
+template <typename Decorated>
+json::Value timedRun(json::Document::AllocatorType& runSummaryAllocator,
+                     size_t sizeUncompressed, size_t numSymbols,
+                     CodingMode codingMode, size_t numberOfRuns,
+                     Decorated&& function) {
+  const std::vector<RunMeasurement> runs =
+      measureRuns(numberOfRuns, std::forward<Decorated>(function));
+  return summarizeRuns(runSummaryAllocator, sizeUncompressed, numSymbols,
+                       codingMode, runs);
 }
@@ -0,0 +1,74 @@
+/*
+ * perfCounters.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Hardware performance counters of the calling thread, read through
+// perf_event_open on Linux. Only user space is counted.
+//
+// Counters the kernel or the machine does not provide, e.g. in a VM or with a
+// restrictive perf_event_paranoid, are reported as unavailable instead of
+// failing. Work done on other threads, e.g. of a ThreadPool, is not counted.
+class PerfCounters {
+ public:
+  enum Counter {
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1DMisses,
+    LLCMisses,
+  };
+  inline static constexpr size_t NUM_COUNTERS = LLCMisses + 1;
+
+  using Values = std::array<uint64_t, NUM_COUNTERS>;
+
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Resets and starts all available counters.
+  void start();
+  // Stops the counters and returns their values, 0 for unavailable ones.
+  // Counters the kernel had to multiplex are scaled from the time they ran
+  // to the time they were enabled.
+  Values stop();
+
+  bool isAvailable(Counter counter) const;
+  bool isAnyAvailable() const;
+
+  static const char* name(Counter counter);
+
+ private:
+  std::array<int, NUM_COUNTERS> fds_;
+};
+
+// The counters of the calling thread, opened on first use.
+PerfCounters& threadPerfCounters();
+
+// Restricts the calling thread to cpu. Threads started afterwards inherit the
+// restriction, so pin after starting worker threads. Returns false if the
+// cpu can not be used.
+bool pinToCpu(int cpu);
+
+// Reference cycles of the time stamp counter as used by the original
+// ryg_rans, or 0 where there is none.
+inline uint64_t readTimestampCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,36 @@
+/*
+ * syntheticData.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Shapes of synthetic source data, from highly skewed to near incompressible.
+enum class Distribution {
+  Uniform,             // every symbol equally likely
+  Geometric,           // exponential decay with a mean of 1/16 of the range
+  Zipf,                // probability of the k-th symbol proportional to 1/k
+  Gaussian,            // ADC like: noise of width 1/32 around a pedestal
+  NearIncompressible,  // uniform, lower half slightly more likely
+};
+
+std::string toString(Distribution distribution);
+
+// Throws if name is not the toString of a Distribution.
+Distribution distributionFromString(const std::string& name);
+
+std::vector<Distribution> allDistributions();
+
+// numSymbols symbols in [0, 1 << alphabetBits) drawn from distribution.
+// Equal seeds give equal data with the same standard library.
+std::vector<uint32_t> generateSymbols(Distribution distribution,
+                                      size_t alphabetBits, size_t numSymbols,
+                                      uint64_t seed);
+
+// Empirical entropy of symbols in bits per symbol.
+double entropy(const std::vector<uint32_t>& symbols);
@@ -5,6 +5,8 @@
  *      Author: Michael Lettrich (michael.lettrich@cern.ch)
  */
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 #include "libcommon/executionTimer.h"
@@ -19,6 +21,33 @@ std::string toString(ExecutionMode mode)
 		case ExecutionMode::Interleaved:
 			return "Interleaved";
 			break;
+		case ExecutionMode::Alias:
+			return "Alias";
+			break;
+		case ExecutionMode::Sparse:
+			return "Sparse";
+			break;
+		case ExecutionMode::SymbolAdaptive:
+			return "SymbolAdaptive";
+			break;
+		case ExecutionMode::Context:
+			return "Context";
+			break;
+		case ExecutionMode::SIMD:
+			return "SIMD";
+			break;
+		case ExecutionMode::Parallel:
+			return "Parallel";
+			break;
+		case ExecutionMode::Streaming:
+			return "Streaming";
+			break;
+		case ExecutionMode::Adaptive:
+			return "Adaptive";
+			break;
+		case ExecutionMode::Columns:
+			return "Columns";
+			break;
 		default:
 			throw std::runtime_error("unknown ExecutionMode");
 			break;
@@ -38,3 +67,106 @@ std::string toString(CodingMode mode){
 			break;
 	}
 }
+
+TimerSettings& timerSettings()
+{
+	static TimerSettings settings;
+	return settings;
+}
+
+RunStatistics runStatistics(std::vector<double> values)
+{
+	if (values.empty()) {
+		throw std::runtime_error("no runs to summarize");
+	}
+	std::sort(values.begin(), values.end());
+	// nearest rank
+	auto percentile = [&](double p) {
+		const size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+		return values[std::max<size_t>(rank, 1) - 1];
+	};
+	return {values.front(), percentile(0.5), percentile(0.99)};
+}
+
+json::Value summarizeRuns(json::Document::AllocatorType& runSummaryAllocator, size_t sizeUncompressed, size_t numSymbols, CodingMode codingMode, const std::vector<RunMeasurement>& runs)
+{
+	const double symbols = static_cast<double>(std::max<size_t>(numSymbols, 1));
+	auto bandwidth = [&](double time) {
+		return static_cast<double>(sizeUncompressed) / (time * MIB_TO_BITS);
+	};
+	auto statistics = [&](auto&& value) {
+		std::vector<double> values;
+		values.reserve(runs.size());
+		for (const auto& run : runs) {
+			values.push_back(value(run));
+		}
+		return runStatistics(std::move(values));
+	};
+
+	json::Value summary(json::kObjectType);
+
+	json::Value bandwidths(json::kArrayType);
+	std::cout << "Bandwidth " << toString(codingMode) << ": [";
+	for (size_t run = 0; run < runs.size(); run++) {
+		const double runBandwidth = bandwidth(runs[run].seconds);
+		bandwidths.PushBack(runBandwidth, runSummaryAllocator);
+		std::cout << std::setprecision(4) << runBandwidth;
+		if (run < runs.size() - 1) {
+			std::cout << ", ";
+		}
+	}
+	std::cout << "] MiB/s" << std::endl;
+	summary.AddMember("Bandwidths", bandwidths, runSummaryAllocator);
+
+	// the slowest runs have the lowest bandwidth.
+	const RunStatistics time = statistics([](const RunMeasurement& run) { return run.seconds; });
+	json::Value timeSummary(json::kObjectType);
+	timeSummary.AddMember("Min", time.min, runSummaryAllocator);
+	timeSummary.AddMember("Median", time.median, runSummaryAllocator);
+	timeSummary.AddMember("P99", time.p99, runSummaryAllocator);
+	summary.AddMember("Time", timeSummary, runSummaryAllocator);
+
+	json::Value bandwidthSummary(json::kObjectType);
+	bandwidthSummary.AddMember("Max", bandwidth(time.min), runSummaryAllocator);
+	bandwidthSummary.AddMember("Median", bandwidth(time.median), runSummaryAllocator);
+	bandwidthSummary.AddMember("P99", bandwidth(time.p99), runSummaryAllocator);
+	summary.AddMember("Bandwidth", bandwidthSummary, runSummaryAllocator);
+	std::cout << "  max/median/p99: " << bandwidth(time.min) << "/" << bandwidth(time.median) << "/" << bandwidth(time.p99) << " MiB/s";
+
+	// clocks per symbol as printed by the original ryg_rans.
+	if (runs.front().timestampCycles != 0) {
+		const RunStatistics cycles = statistics([&](const RunMeasurement& run) { return run.timestampCycles / symbols; });
+		json::Value cyclesSummary(json::kObjectType);
+		cyclesSummary.AddMember("Min", cycles.min, runSummaryAllocator);
+		cyclesSummary.AddMember("Median", cycles.median, runSummaryAllocator);
+		cyclesSummary.AddMember("P99", cycles.p99, runSummaryAllocator);
+		summary.AddMember("CyclesPerSymbol", cyclesSummary, runSummaryAllocator);
+		std::cout << ", " << cycles.median << " clocks/symbol";
+	}
+
+	const PerfCounters& counters = threadPerfCounters();
+	if (counters.isAnyAvailable()) {
+		json::Value counterSummary(json::kObjectType);
+		std::cout << ", per symbol:";
+		for (size_t i = 0; i < PerfCounters::NUM_COUNTERS; i++) {
+			const auto counter = static_cast<PerfCounters::Counter>(i);
+			if (!counters.isAvailable(counter)) {
+				continue;
+			}
+			const double perSymbol = statistics([&](const RunMeasurement& run) { return run.counters[counter] / symbols; }).median;
+			counterSummary.AddMember(json::StringRef(PerfCounters::name(counter)), perSymbol, runSummaryAllocator);
+			std::cout << " " << PerfCounters::name(counter) << " " << perSymbol;
+		}
+		if (counters.isAvailable(PerfCounters::Cycles) && counters.isAvailable(PerfCounters::Instructions)) {
+			const double ipc = statistics([](const RunMeasurement& run) {
+				return static_cast<double>(run.counters[PerfCounters::Instructions]) / std::max<uint64_t>(run.counters[PerfCounters::Cycles], 1);
+			}).median;
+			counterSummary.AddMember("InstructionsPerCycle", ipc, runSummaryAllocator);
+			std::cout << ", IPC " << ipc;
+		}
+		summary.AddMember("Counters", counterSummary, runSummaryAllocator);
+	}
+	std::cout << std::endl;
+
+	return summary;
+}
@@ -0,0 +1,168 @@
+/*
+ * perfCounters.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "libcommon/perfCounters.h"
+
+#include <stdexcept>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+perf_event_attr attributes(PerfCounters::Counter counter) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // more counters than the PMU has are multiplexed, see PerfCounters::stop.
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  auto cacheMisses = [&](uint64_t cache) {
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  };
+
+  switch (counter) {
+    case PerfCounters::Cycles:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case PerfCounters::Instructions:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case PerfCounters::BranchMisses:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    case PerfCounters::L1DMisses:
+      cacheMisses(PERF_COUNT_HW_CACHE_L1D);
+      break;
+    case PerfCounters::LLCMisses:
+      cacheMisses(PERF_COUNT_HW_CACHE_LL);
+      break;
+    default:
+      throw std::runtime_error("unknown Counter");
+  }
+  return attr;
+}
+#endif
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+#ifdef __linux__
+  for (size_t counter = 0; counter < NUM_COUNTERS; counter++) {
+    perf_event_attr attr = attributes(static_cast<Counter>(counter));
+    fds_[counter] =
+        static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+PerfCounters::Values PerfCounters::stop() {
+  Values values{};
+#ifdef __linux__
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (size_t counter = 0; counter < NUM_COUNTERS; counter++) {
+    // value, time enabled and time running, see read_format.
+    uint64_t data[3] = {};
+    if (fds_[counter] >= 0 &&
+        read(fds_[counter], data, sizeof(data)) == sizeof(data) &&
+        data[2] > 0) {
+      // a multiplexed counter only ran for part of the time it was enabled.
+      values[counter] = static_cast<uint64_t>(
+          static_cast<double>(data[0]) * data[1] / data[2]);
+    }
+  }
+#endif
+  return values;
+}
+
+bool PerfCounters::isAvailable(Counter counter) const {
+  return fds_[counter] >= 0;
+}
+
+bool PerfCounters::isAnyAvailable() const {
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const char* PerfCounters::name(Counter counter) {
+  switch (counter) {
+    case Cycles:
+      return "Cycles";
+    case Instructions:
+      return "Instructions";
+    case BranchMisses:
+      return "BranchMisses";
+    case L1DMisses:
+      return "L1DMisses";
+    case LLCMisses:
+      return "LLCMisses";
+    default:
+      throw std::runtime_error("unknown Counter");
+  }
+}
+
+PerfCounters& threadPerfCounters() {
+  thread_local PerfCounters counters;
+  return counters;
+}
+
+bool pinToCpu(int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+  static_cast<void>(cpu);
+  return false;
+#endif
+}
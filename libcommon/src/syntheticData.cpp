@@ -0,0 +1,124 @@
+/*
+ * syntheticData.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "libcommon/syntheticData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+std::string toString(Distribution distribution) {
+  switch (distribution) {
+    case Distribution::Uniform:
+      return "Uniform";
+    case Distribution::Geometric:
+      return "Geometric";
+    case Distribution::Zipf:
+      return "Zipf";
+    case Distribution::Gaussian:
+      return "Gaussian";
+    case Distribution::NearIncompressible:
+      return "NearIncompressible";
+    default:
+      throw std::runtime_error("unknown Distribution");
+  }
+}
+
+Distribution distributionFromString(const std::string& name) {
+  for (const Distribution distribution : allDistributions()) {
+    if (toString(distribution) == name) {
+      return distribution;
+    }
+  }
+  throw std::runtime_error("unknown Distribution " + name);
+}
+
+std::vector<Distribution> allDistributions() {
+  return {Distribution::Uniform, Distribution::Geometric, Distribution::Zipf,
+          Distribution::Gaussian, Distribution::NearIncompressible};
+}
+
+std::vector<uint32_t> generateSymbols(Distribution distribution,
+                                      size_t alphabetBits, size_t numSymbols,
+                                      uint64_t seed) {
+  if (alphabetBits == 0 || alphabetBits > 24) {
+    throw std::runtime_error("alphabet bits must be in [1, 24]");
+  }
+  const uint32_t alphabetSize = 1u << alphabetBits;
+  const uint32_t maxSymbol = alphabetSize - 1;
+  std::mt19937_64 generator(seed);
+  std::vector<uint32_t> symbols(numSymbols);
+
+  auto fill = [&](auto&& draw) {
+    std::generate(symbols.begin(), symbols.end(), draw);
+  };
+
+  switch (distribution) {
+    case Distribution::Uniform: {
+      std::uniform_int_distribution<uint32_t> uniform(0, maxSymbol);
+      fill([&]() { return uniform(generator); });
+      break;
+    }
+    case Distribution::Geometric: {
+      std::geometric_distribution<uint32_t> geometric(
+          1.0 / (1.0 + alphabetSize / 16.0));
+      fill([&]() { return std::min(geometric(generator), maxSymbol); });
+      break;
+    }
+    case Distribution::Zipf: {
+      std::vector<double> weights(alphabetSize);
+      for (uint32_t rank = 0; rank < alphabetSize; rank++) {
+        weights[rank] = 1.0 / (rank + 1);
+      }
+      std::discrete_distribution<uint32_t> zipf(weights.begin(),
+                                                weights.end());
+      fill([&]() { return zipf(generator); });
+      break;
+    }
+    case Distribution::Gaussian: {
+      std::normal_distribution<double> normal(alphabetSize / 4.0,
+                                              alphabetSize / 32.0);
+      fill([&]() {
+        const double value = std::round(normal(generator));
+        return static_cast<uint32_t>(
+            std::clamp(value, 0.0, static_cast<double>(maxSymbol)));
+      });
+      break;
+    }
+    case Distribution::NearIncompressible: {
+      std::bernoulli_distribution upperHalf(0.45);
+      std::uniform_int_distribution<uint32_t> half(0, maxSymbol >> 1);
+      const uint32_t upperOffset = alphabetSize >> 1;
+      fill([&]() {
+        return half(generator) + (upperHalf(generator) ? upperOffset : 0);
+      });
+      break;
+    }
+    default:
+      throw std::runtime_error("unknown Distribution");
+  }
+  return symbols;
+}
+
+double entropy(const std::vector<uint32_t>& symbols) {
+  if (symbols.empty()) {
+    return 0;
+  }
+  std::vector<size_t> counts(
+      *std::max_element(symbols.begin(), symbols.end()) + size_t(1));
+  for (const uint32_t symbol : symbols) {
+    counts[symbol]++;
+  }
+  double bits = 0;
+  for (const size_t count : counts) {
+    if (count > 0) {
+      const double probability = static_cast<double>(count) / symbols.size();
+      bits -= probability * std::log2(probability);
+    }
+  }
+  return bits;
+}
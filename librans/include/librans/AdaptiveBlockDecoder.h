@@ -0,0 +1,102 @@
+/*
+ * AdaptiveBlockDecoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <future>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "AdaptiveDictionary.h"
+#include "ByteIO.h"
+#include "Decoder.h"
+#include "EncodedBlocks.h"
+#include "SymbolStatistics.h"
+#include "ThreadPool.h"
+
+namespace rans {
+
+// Decodes the blocks written by AdaptiveBlockEncoder<coder_T, stream_T, N> in
+// parallel. Table updates are replayed in order first, then a Decoder is built
+// for every distinct table.
+template <typename coder_T, typename stream_T, size_t N>
+class AdaptiveBlockDecoder {
+ public:
+  explicit AdaptiveBlockDecoder(size_t probabilityBits);
+
+  // output has to hold encoded.blocks.numSymbols() symbols and may be any
+  // random access iterator.
+  template <typename source_IT>
+  void decode(const EncodedAdaptiveBlocks<stream_T>& encoded,
+              source_IT output, ThreadPool& pool) const;
+
+ private:
+  size_t probabilityBits_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+AdaptiveBlockDecoder<coder_T, stream_T, N>::AdaptiveBlockDecoder(
+    size_t probabilityBits)
+    : probabilityBits_(probabilityBits) {}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+void AdaptiveBlockDecoder<coder_T, stream_T, N>::decode(
+    const EncodedAdaptiveBlocks<stream_T>& encoded, source_IT output,
+    ThreadPool& pool) const {
+  const auto& index = encoded.blocks.index;
+
+  AdaptiveDictionary dictionary(probabilityBits_);
+  ByteReader reader(encoded.tableUpdates.data(), encoded.tableUpdates.size());
+  std::vector<std::shared_ptr<const SymbolStatistics>> tables(index.size());
+  for (auto& table : tables) {
+    dictionary.decodeUpdate(reader);
+    table = dictionary.getTable();
+  }
+  if (reader.remaining() != 0) {
+    throw std::runtime_error("corrupt data: trailing table updates");
+  }
+
+  using decoder_t = Decoder<coder_T, stream_T, N>;
+  std::map<const SymbolStatistics*, std::unique_ptr<decoder_t>> decoders;
+  for (const auto& table : tables) {
+    decoders[table.get()];
+  }
+  std::vector<std::future<void>> tasks;
+  for (auto& entry : decoders) {
+    tasks.push_back(pool.submit([this, &entry]() {
+      entry.second =
+          std::make_unique<decoder_t>(*entry.first, probabilityBits_);
+    }));
+  }
+  waitAll(tasks);
+
+  // every block is decoded within its index entry, which has to lie in the
+  // stream.
+  const size_t streamSize = encoded.blocks.stream.size();
+  for (const BlockIndexEntry& entry : index) {
+    if (entry.offset > streamSize || entry.size > streamSize - entry.offset) {
+      throw std::runtime_error("corrupt data: invalid block index");
+    }
+  }
+
+  tasks.clear();
+  const stream_T* stream = encoded.blocks.stream.data();
+  for (size_t block = 0; block < index.size(); block++) {
+    const decoder_t* decoder = decoders.at(tables[block].get()).get();
+    const BlockIndexEntry& entry = index[block];
+    tasks.push_back(pool.submit([decoder, stream, &entry, output]() {
+      const stream_T* begin = stream + entry.offset;
+      decoder->decode(begin, begin + entry.size, output, entry.numSymbols);
+    }));
+    output += entry.numSymbols;
+  }
+  waitAll(tasks);
+}
+
+}  // namespace rans
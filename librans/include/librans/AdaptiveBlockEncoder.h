@@ -0,0 +1,126 @@
+/*
+ * AdaptiveBlockEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "AdaptiveDictionary.h"
+#include "BlockEncoder.h"
+#include "EncodedBlocks.h"
+#include "Encoder.h"
+#include "Histogram.h"
+#include "OutputBuffer.h"
+#include "SymbolStatistics.h"
+#include "ThreadPool.h"
+
+namespace rans {
+
+// Like BlockEncoder, but every block gets its own table, sent as an update of
+// the table of the previous block, see AdaptiveDictionary. Blocks that keep
+// the previous table share its Encoder, so tables are only rebuilt when they
+// change. Scratch buffers are reused across calls, as in BlockEncoder.
+template <typename coder_T, typename stream_T, size_t N>
+class AdaptiveBlockEncoder {
+ public:
+  AdaptiveBlockEncoder(size_t probabilityBits, size_t blockSize);
+
+  // [begin, end) may be any random access iterators.
+  template <typename source_IT>
+  EncodedAdaptiveBlocks<stream_T> encode(source_IT begin, source_IT end,
+                                         ThreadPool& pool) const;
+
+  size_t getBlockSize() const;
+
+ private:
+  size_t probabilityBits_;
+  size_t blockSize_;
+  mutable OutputArena<stream_T> arena_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+AdaptiveBlockEncoder<coder_T, stream_T, N>::AdaptiveBlockEncoder(
+    size_t probabilityBits, size_t blockSize)
+    : probabilityBits_(probabilityBits), blockSize_(blockSize) {
+  if (blockSize_ == 0) {
+    throw std::runtime_error("block size must not be 0");
+  }
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+EncodedAdaptiveBlocks<stream_T>
+AdaptiveBlockEncoder<coder_T, stream_T, N>::encode(source_IT begin,
+                                                   source_IT end,
+                                                   ThreadPool& pool) const {
+  const size_t numSymbols = end - begin;
+  const size_t numBlocks = (numSymbols + blockSize_ - 1) / blockSize_;
+
+  // statistics of all blocks are independent ...
+  std::vector<int64_t> mins(numBlocks);
+  std::vector<std::vector<uint32_t>> counts(numBlocks);
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(numBlocks);
+  for (size_t block = 0; block < numBlocks; block++) {
+    tasks.push_back(pool.submit([&, block]() {
+      const source_IT blockBegin = begin + block * blockSize_;
+      const source_IT blockEnd =
+          blockBegin + std::min(blockSize_, numSymbols - block * blockSize_);
+      const auto range = tokenRange(blockBegin, blockEnd);
+      mins[block] = range.first;
+      counts[block] = histogram(
+          blockBegin, blockEnd, mins[block],
+          static_cast<int64_t>(range.second) - range.first + 1);
+    }));
+  }
+  waitAll(tasks);
+
+  // ... but each table update depends on the previous table.
+  EncodedAdaptiveBlocks<stream_T> encoded;
+  AdaptiveDictionary dictionary(probabilityBits_);
+  std::vector<std::shared_ptr<const SymbolStatistics>> tables(numBlocks);
+  for (size_t block = 0; block < numBlocks; block++) {
+    dictionary.encodeUpdate(mins[block], counts[block], encoded.tableUpdates);
+    tables[block] = dictionary.getTable();
+    std::vector<uint32_t>().swap(counts[block]);
+  }
+
+  // one Encoder per distinct table, built in parallel.
+  using encoder_t = Encoder<coder_T, stream_T, N>;
+  std::map<const SymbolStatistics*, std::unique_ptr<encoder_t>> encoders;
+  for (const auto& table : tables) {
+    encoders[table.get()];
+  }
+  tasks.clear();
+  for (auto& entry : encoders) {
+    tasks.push_back(pool.submit([this, &entry]() {
+      entry.second =
+          std::make_unique<encoder_t>(*entry.first, probabilityBits_);
+    }));
+  }
+  waitAll(tasks);
+
+  encoded.blocks = encodeBlocks<coder_T, stream_T, N>(
+      begin, end, blockSize_, probabilityBits_, pool, arena_,
+      [&](size_t block, source_IT blockBegin, source_IT blockEnd,
+          stream_T* bufferBegin, stream_T* bufferEnd) {
+        return encoders.at(tables[block].get())
+            ->encode(blockBegin, blockEnd, bufferBegin, bufferEnd);
+      });
+  return encoded;
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+size_t AdaptiveBlockEncoder<coder_T, stream_T, N>::getBlockSize() const {
+  return blockSize_;
+}
+
+}  // namespace rans
@@ -0,0 +1,164 @@
+/*
+ * AdaptiveCDF.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rans {
+
+// Cumulative frequencies of a small alphabet that adapt to the coded data
+// after every symbol, as the CDFs of Daala and AV1 do. Encoder and decoder
+// start from a uniform distribution, so nothing has to be counted or
+// transmitted up front.
+//
+// Every symbol keeps a frequency of at least 1. The remaining
+// (1 << PROBABILITY_BITS) - size() units are spread by exponential decay:
+// after coding symbol s, the adaptive mass a_i of all symbols below i moves
+// by 2^-rate of its distance towards 0 for i <= s and towards the total for
+// i > s, which takes mass from all symbols and hands it to s. The rate starts
+// fast and slows down over the first 32 symbols.
+//
+// The starts of all symbols are kept in MAX_SYMBOLS uint16_t lanes, padded
+// with values larger than any slot, so with SSE2 an update is a few vector
+// operations and finding the symbol of a slot is one compare and a popcount.
+class AdaptiveCDF {
+ public:
+  static constexpr size_t MAX_SYMBOLS = 16;
+  static constexpr uint32_t PROBABILITY_BITS = 15;
+
+  // Uniform distribution over the symbols 0, ..., numSymbols - 1.
+  explicit AdaptiveCDF(size_t numSymbols);
+
+  size_t size() const { return numSymbols_; }
+
+  uint32_t start(uint32_t symbol) const { return starts_[symbol]; }
+
+  uint32_t frequency(uint32_t symbol) const {
+    return starts_[symbol + 1] - starts_[symbol];
+  }
+
+  // Symbol owning slot, with 0 <= slot < 1 << PROBABILITY_BITS.
+  inline uint32_t find(uint32_t slot) const;
+
+  // Adapts to one more occurrence of symbol.
+  inline void update(uint32_t symbol);
+
+  // The portable versions of find and update, which those fall back to
+  // without SSE2. Both versions give identical results.
+  inline uint32_t findScalar(uint32_t slot) const;
+  inline void updateScalar(uint32_t symbol);
+
+ private:
+  // adaptive mass available besides the minimal frequency of every symbol.
+  uint32_t scale() const {
+    return (1u << PROBABILITY_BITS) - static_cast<uint32_t>(numSymbols_);
+  }
+
+  // rate of the next update, which slows down over the first symbols.
+  uint32_t nextRate() {
+    const uint32_t rate = baseRate_ + (count_ > 15) + (count_ > 31);
+    count_ += count_ < 32;
+    return rate;
+  }
+
+#ifdef __SSE2__
+  inline uint32_t findSSE2(uint32_t slot) const;
+  inline void updateSSE2(uint32_t symbol);
+#endif
+
+  // starts_[numSymbols_] is the total, the lanes behind it are padding.
+  alignas(16) uint16_t starts_[MAX_SYMBOLS + 8];
+  size_t numSymbols_;
+  uint32_t baseRate_;
+  uint32_t count_ = 0;
+};
+
+inline uint32_t AdaptiveCDF::find(uint32_t slot) const {
+#ifdef __SSE2__
+  return findSSE2(slot);
+#else
+  return findScalar(slot);
+#endif
+}
+
+inline void AdaptiveCDF::update(uint32_t symbol) {
+#ifdef __SSE2__
+  updateSSE2(symbol);
+#else
+  updateScalar(symbol);
+#endif
+}
+
+inline uint32_t AdaptiveCDF::findScalar(uint32_t slot) const {
+  uint32_t symbol = 0;
+  for (size_t i = 1; i < MAX_SYMBOLS; i++) {
+    symbol += starts_[i] <= slot;
+  }
+  return symbol;
+}
+
+inline void AdaptiveCDF::updateScalar(uint32_t symbol) {
+  const uint32_t rate = nextRate();
+  for (size_t i = 1; i < numSymbols_; i++) {
+    const uint32_t mass = starts_[i] - i;
+    if (i > symbol) {
+      starts_[i] = mass + ((scale() - mass) >> rate) + i;
+    } else {
+      starts_[i] = mass - (mass >> rate) + i;
+    }
+  }
+}
+
+#ifdef __SSE2__
+inline uint32_t AdaptiveCDF::findSSE2(uint32_t slot) const {
+  // number of starts <= slot, compared signed after flipping the sign bit.
+  const __m128i bias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+  const __m128i key = _mm_xor_si128(_mm_set1_epi16(slot), bias);
+  const __m128i low = _mm_xor_si128(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(starts_)), bias);
+  const __m128i high = _mm_xor_si128(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(starts_ + 8)), bias);
+  const uint32_t above =
+      _mm_movemask_epi8(_mm_packs_epi16(_mm_cmpgt_epi16(low, key),
+                                        _mm_cmpgt_epi16(high, key)));
+  return MAX_SYMBOLS - __builtin_popcount(above) - 1;
+}
+
+inline void AdaptiveCDF::updateSSE2(uint32_t symbol) {
+  const __m128i shift = _mm_cvtsi32_si128(nextRate());
+  const __m128i scale = _mm_set1_epi16(this->scale());
+  const __m128i coded = _mm_set1_epi16(symbol);
+  const __m128i numSymbols = _mm_set1_epi16(numSymbols_);
+  for (size_t half = 0; half < MAX_SYMBOLS; half += 8) {
+    __m128i* lanes = reinterpret_cast<__m128i*>(starts_ + half);
+    const __m128i index = _mm_add_epi16(
+        _mm_set_epi16(7, 6, 5, 4, 3, 2, 1, 0), _mm_set1_epi16(half));
+    const __m128i starts = _mm_load_si128(lanes);
+    const __m128i mass = _mm_sub_epi16(starts, index);
+
+    const __m128i up =
+        _mm_add_epi16(mass, _mm_srl_epi16(_mm_sub_epi16(scale, mass), shift));
+    const __m128i down = _mm_sub_epi16(mass, _mm_srl_epi16(mass, shift));
+    const __m128i above = _mm_cmpgt_epi16(index, coded);
+    const __m128i updated = _mm_add_epi16(
+        _mm_or_si128(_mm_and_si128(above, up), _mm_andnot_si128(above, down)),
+        index);
+
+    // the total and the padding stay as they are.
+    const __m128i valid = _mm_cmplt_epi16(index, numSymbols);
+    _mm_store_si128(lanes, _mm_or_si128(_mm_and_si128(valid, updated),
+                                        _mm_andnot_si128(valid, starts)));
+  }
+}
+#endif
+
+}  // namespace rans
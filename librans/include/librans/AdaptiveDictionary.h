@@ -0,0 +1,67 @@
+/*
+ * AdaptiveDictionary.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ByteIO.h"
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// How the table of a block is derived from the table of the previous block.
+enum class TableUpdate : uint8_t { Reuse = 0, Delta = 1, Replace = 2 };
+
+// Sequence of tables for consecutive blocks of drifting data. Each block is
+// coded with a table that is sent as an update of the previous one.
+//
+// For every block the encoder estimates the bits of
+// - Reuse: coding the block with the previous table, sending nothing.
+// - Delta: normalizing the counts of the block itself and sending the
+//   difference to the previous frequencies.
+// - Replace: the same table sent in full.
+// and picks the cheapest.
+//
+// Layout of an update: the mode as one byte. Delta and Replace continue with
+// min (zigzag varint) and the number of frequencies (varint), followed for
+// Replace by the frequencies and for Delta by the zigzag coded differences to
+// the previous frequency of each symbol, 0 outside of the previous table.
+// Both are run length coded varints, see ByteWriter, so unchanged symbols
+// cost little.
+class AdaptiveDictionary {
+ public:
+  explicit AdaptiveDictionary(size_t probabilityBits);
+
+  // Picks the update for a block with counts of the symbols min, min + 1, ...,
+  // appends it to updates and makes the resulting table current.
+  TableUpdate encodeUpdate(int min, const std::vector<uint32_t>& counts,
+                           std::vector<uint8_t>& updates);
+
+  // Reads the next update from reader and applies it.
+  TableUpdate decodeUpdate(ByteReader& reader);
+
+  // The current table, shared by all blocks since its last update.
+  std::shared_ptr<const SymbolStatistics> getTable() const;
+
+  size_t getProbabilityBits() const;
+
+ private:
+  // Bits to code the symbols min, min + 1, ... counts times with table,
+  // infinite if table lacks one of them.
+  double codingCost(int min, const std::vector<uint32_t>& counts,
+                    const SymbolStatistics& table) const;
+
+  // Frequency of symbol in the current table, 0 if there is none.
+  uint32_t currentFrequency(int symbol) const;
+
+  size_t probabilityBits_;
+  std::shared_ptr<const SymbolStatistics> table_;
+};
+
+}  // namespace rans
@@ -0,0 +1,30 @@
+/*
+ * AliasEncoderSymbol.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "EncoderSymbol.h"
+
+namespace rans {
+
+// Encoder symbol for a symbol whose slots were scattered by an AliasTable.
+//
+// symbol codes the symbol as if it started at 0, which turns x into
+// (x / freq) * M + x % freq. The remainder then selects the slot from slots,
+// the freq slots owned by the symbol in increasing order.
+template <typename T>
+struct AliasEncoderSymbol {
+  AliasEncoderSymbol(uint32_t freq, const uint32_t* slots,
+                     uint32_t probabilityBits)
+      : symbol(0, freq, probabilityBits), slots(slots){};
+
+  EncoderSymbol<T> symbol;
+  const uint32_t* slots;
+};
+
+}  // namespace rans
@@ -0,0 +1,112 @@
+/*
+ * AliasTable.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "AliasEncoderSymbol.h"
+#include "DecoderTable.h"
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Decoder table built with the alias method, for large symbol ranges.
+//
+// The 1 << probabilityBits slots are split into a power of two number of
+// equally sized buckets, at least as many as there are symbols with non zero
+// frequency. Every bucket is owned by at most two symbols: slots below the
+// divider belong to the first, the rest to the second. Symbols therefore no
+// longer own a contiguous range of slots, and the stream has to be written by
+// an encoder using AliasSymbolTable.
+//
+// Lookup is O(1), but memory is proportional to the number of symbols instead
+// of to the number of slots, so the table stays cache resident for alphabets
+// where a DecoderTable does not.
+class AliasTable {
+ public:
+  AliasTable(const SymbolStatistics& stats, size_t probabilityBits);
+
+  size_t getProbabilityBits() const;
+
+  size_t getNumBuckets() const;
+
+  // Same interface as DecoderTable::visit, there is just one layout.
+  template <typename F>
+  decltype(auto) visit(F&& f) const;
+
+  // start is chosen such that slot - start is the offset of the slot among all
+  // slots owned by symbol, which is all the decoder step needs.
+  inline DecoderTableEntry operator[](uint32_t slot) const;
+
+ private:
+  struct Bucket {
+    uint32_t divider;
+    int symbol[2];
+    uint32_t start[2];
+    uint32_t freq[2];
+  };
+
+  uint32_t probabilityBits_;
+  uint32_t bucketShift_;
+  std::vector<Bucket> buckets_;
+};
+
+// Encoder symbols matching the slot layout of an AliasTable.
+template <typename T>
+class AliasSymbolTable {
+ public:
+  AliasSymbolTable(const SymbolStatistics& stats, size_t probabilityBits);
+
+  // the slots refer to this table, so it has to stay where it is.
+  AliasSymbolTable(const AliasSymbolTable&) = delete;
+  AliasSymbolTable& operator=(const AliasSymbolTable&) = delete;
+
+  const AliasEncoderSymbol<T>& operator[](int index) const {
+    return symbolTable_[index - min_];
+  }
+
+ private:
+  int min_;
+  // for every symbol the slots it owns, in order of the cumulative frequency.
+  std::vector<uint32_t> slots_;
+  std::vector<AliasEncoderSymbol<T>> symbolTable_;
+};
+
+template <typename F>
+decltype(auto) AliasTable::visit(F&& f) const {
+  return f(*this);
+}
+
+inline DecoderTableEntry AliasTable::operator[](uint32_t slot) const {
+  const Bucket& bucket = buckets_[slot >> bucketShift_];
+  const size_t owner = slot >= bucket.divider;
+  return {bucket.symbol[owner], bucket.start[owner], bucket.freq[owner]};
+}
+
+template <typename T>
+AliasSymbolTable<T>::AliasSymbolTable(const SymbolStatistics& stats,
+                                      size_t probabilityBits)
+    : min_(stats.minSymbol()),
+      slots_(static_cast<size_t>(1) << probabilityBits) {
+  // invert the decoder table: slot - start is the offset of the slot within
+  // the cumulative range of its symbol.
+  const AliasTable aliasTable(stats, probabilityBits);
+  for (uint32_t slot = 0; slot < slots_.size(); slot++) {
+    const DecoderTableEntry entry = aliasTable[slot];
+    const uint32_t cumulative = stats[entry.symbol].second;
+    slots_[cumulative + slot - entry.start] = slot;
+  }
+
+  symbolTable_.reserve(stats.size());
+  for (const auto& entry : stats) {
+    symbolTable_.emplace_back(entry.first, slots_.data() + entry.second,
+                              probabilityBits);
+  }
+}
+
+}  // namespace rans
@@ -0,0 +1,183 @@
+/*
+ * BinaryDictionary.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Decoder.h"
+#include "DecoderTable.h"
+#include "Encoder.h"
+#include "EncoderSymbol.h"
+#include "SymbolStatistics.h"
+#include "SymbolTable.h"
+
+namespace rans {
+
+// Fixed size header at the start of a binary dictionary.
+struct BinaryDictionaryHeader {
+  char magic[4];                // "rDCT"
+  uint32_t byteOrder;           // BYTE_ORDER_MARK in the writer's byte order
+  uint16_t version;
+  uint8_t probabilityBits;      // frequencies sum up to 1 << probabilityBits
+  uint8_t coderBits;            // state width of the encoder table, 0 if none
+  uint8_t decoderEntryBytes;    // packing of the decoder table, 0 if none
+  uint8_t reserved[3];
+  int32_t min;                  // symbol of the first frequency
+  uint32_t numSymbols;          // number of frequencies
+  uint32_t encoderSymbolBytes;  // sizeof(EncoderSymbol<coder_T>)
+  uint32_t reserved2;
+  uint64_t frequenciesOffset;   // section offsets from the start, 0 if absent
+  uint64_t decoderTableOffset;
+  uint64_t encoderTableOffset;
+  uint64_t size;                // of the whole dictionary in bytes
+  uint64_t checksum;            // of the whole dictionary, this field as 0
+};
+static_assert(sizeof(BinaryDictionaryHeader) == 72, "header must be packed");
+
+// Dictionary in a binary format that is used in place.
+//
+// Layout, in native byte order:
+//
+//   header | frequencies | decoder table | encoder table
+//
+// - frequencies: numSymbols normalized frequencies as uint32_t.
+// - decoder table: optional, the packed entries of a DecoderTable.
+// - encoder table: optional, numSymbols EncoderSymbol<coder_T>.
+//
+// The total size is padded to a multiple of 8 bytes.
+//
+// Every section starts at a multiple of SECTION_ALIGNMENT, so a dictionary
+// that was mmapped or read into suitably aligned memory can be coded with
+// directly through DictionaryEncoder and DictionaryDecoder, without parsing or
+// allocating anything.
+class BinaryDictionary {
+ public:
+  inline static constexpr char MAGIC[4] = {'r', 'D', 'C', 'T'};
+  inline static constexpr uint16_t VERSION = 2;
+  inline static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+  inline static constexpr size_t SECTION_ALIGNMENT = 64;
+
+  // coder_T selects the layout of the encoder table. Throws unless
+  // probabilityBits is at most 32, or at most what coder_T supports with an
+  // encoder table, and the frequencies of stats sum up to
+  // 1 << probabilityBits, as the reader requires.
+  template <typename coder_T>
+  static std::vector<uint8_t> serialize(const SymbolStatistics& stats,
+                                        size_t probabilityBits,
+                                        bool withDecoderTable = true,
+                                        bool withEncoderTable = true);
+
+  // Whether data starts like a binary dictionary, to tell it from JSON.
+  static bool isBinaryDictionary(const void* data, size_t size);
+
+  // MurmurHash64A of size bytes.
+  static uint64_t checksum(const void* data, size_t size);
+
+  // checksum of the size bytes of a dictionary with its checksum field read
+  // as 0, as stored in BinaryDictionaryHeader. Covers the header, so
+  // corrupted sizes, offsets and settings are caught as well.
+  static uint64_t dictionaryChecksum(const void* data, size_t size);
+
+ private:
+  friend class BinaryDictionaryView;
+
+  // coderBits is the state width of the encoder table, 0 if there is none.
+  static void checkStatistics(const SymbolStatistics& stats,
+                              size_t probabilityBits, size_t coderBits);
+
+  static void checkStatistics(const uint32_t* frequencies, size_t numSymbols,
+                              size_t probabilityBits, size_t coderBits);
+
+  static std::vector<uint8_t> serialize(const SymbolStatistics& stats,
+                                        size_t probabilityBits,
+                                        bool withDecoderTable,
+                                        size_t coderBits,
+                                        const void* encoderTable,
+                                        size_t encoderSymbolBytes);
+};
+
+// Validated, non owning view of a binary dictionary. data has to stay valid
+// and aligned to 8 bytes.
+class BinaryDictionaryView {
+ public:
+  // Checking the checksum reads the whole dictionary once.
+  BinaryDictionaryView(const void* data, size_t size,
+                       bool verifyChecksum = true);
+
+  const BinaryDictionaryHeader& getHeader() const;
+
+  size_t getProbabilityBits() const;
+  int getMinSymbol() const;
+  size_t size() const;
+  const uint32_t* getFrequencies() const;
+
+  // Copies the frequencies into statistics for code not using the views.
+  SymbolStatistics getSymbolStatistics() const;
+
+  bool hasDecoderTable() const;
+  DecoderTableView getDecoderTable() const;
+
+  template <typename coder_T>
+  bool hasEncoderTable() const;
+  template <typename coder_T>
+  SymbolTableView<EncoderSymbol<coder_T>> getEncoderTable() const;
+
+ private:
+  const uint8_t* data_;
+  const BinaryDictionaryHeader* header_;
+};
+
+// Coders working directly on the tables of a BinaryDictionaryView.
+template <typename coder_T, typename stream_T, size_t N>
+using DictionaryEncoder =
+    Encoder<coder_T, stream_T, N, SymbolTableView<EncoderSymbol<coder_T>>>;
+
+template <typename coder_T, typename stream_T, size_t N>
+using DictionaryDecoder = Decoder<coder_T, stream_T, N, DecoderTableView>;
+
+template <typename coder_T>
+std::vector<uint8_t> BinaryDictionary::serialize(const SymbolStatistics& stats,
+                                                 size_t probabilityBits,
+                                                 bool withDecoderTable,
+                                                 bool withEncoderTable) {
+  checkStatistics(stats, probabilityBits,
+                  withEncoderTable ? sizeof(coder_T) * 8 : 0);
+  std::vector<EncoderSymbol<coder_T>> encoderTable;
+  if (withEncoderTable) {
+    encoderTable.reserve(stats.size());
+    for (const auto& entry : stats) {
+      encoderTable.emplace_back(entry.second, entry.first, probabilityBits);
+    }
+  }
+  return serialize(stats, probabilityBits, withDecoderTable,
+                   withEncoderTable ? sizeof(coder_T) * 8 : 0,
+                   encoderTable.data(),
+                   withEncoderTable ? sizeof(EncoderSymbol<coder_T>) : 0);
+}
+
+template <typename coder_T>
+bool BinaryDictionaryView::hasEncoderTable() const {
+  return header_->encoderTableOffset != 0 &&
+         header_->coderBits == sizeof(coder_T) * 8 &&
+         header_->encoderSymbolBytes == sizeof(EncoderSymbol<coder_T>);
+}
+
+template <typename coder_T>
+SymbolTableView<EncoderSymbol<coder_T>> BinaryDictionaryView::getEncoderTable()
+    const {
+  if (!hasEncoderTable<coder_T>()) {
+    throw std::runtime_error("dictionary has no matching encoder table");
+  }
+  return SymbolTableView<EncoderSymbol<coder_T>>(
+      reinterpret_cast<const EncoderSymbol<coder_T>*>(
+          data_ + header_->encoderTableOffset),
+      header_->min);
+}
+
+}  // namespace rans
@@ -0,0 +1,71 @@
+/*
+ * BlockDecoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <future>
+#include <vector>
+
+#include "Decoder.h"
+#include "EncodedBlocks.h"
+#include "SymbolStatistics.h"
+#include "ThreadPool.h"
+
+namespace rans {
+
+// Decodes the blocks written by BlockEncoder<coder_T, stream_T, N> in parallel.
+template <typename coder_T, typename stream_T, size_t N>
+class BlockDecoder {
+ public:
+  BlockDecoder(const SymbolStatistics& stats, size_t probabilityBits);
+
+  // output has to hold blocks.numSymbols() symbols and may be any random
+  // access iterator.
+  template <typename source_IT>
+  void decode(const EncodedBlocks<stream_T>& blocks, source_IT output,
+              ThreadPool& pool) const;
+
+  // Same, for a stream that is not owned by EncodedBlocks, e.g. a Frame payload.
+  // Every block is decoded within its index entry and throws if it overruns.
+  template <typename source_IT>
+  void decode(const stream_T* stream, const std::vector<BlockIndexEntry>& index,
+              source_IT output, ThreadPool& pool) const;
+
+ private:
+  Decoder<coder_T, stream_T, N> decoder_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+BlockDecoder<coder_T, stream_T, N>::BlockDecoder(const SymbolStatistics& stats,
+                                                 size_t probabilityBits)
+    : decoder_(stats, probabilityBits) {}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+void BlockDecoder<coder_T, stream_T, N>::decode(
+    const EncodedBlocks<stream_T>& blocks, source_IT output,
+    ThreadPool& pool) const {
+  decode(blocks.stream.data(), blocks.index, output, pool);
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+void BlockDecoder<coder_T, stream_T, N>::decode(
+    const stream_T* stream, const std::vector<BlockIndexEntry>& index,
+    source_IT output, ThreadPool& pool) const {
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(index.size());
+  for (const auto& entry : index) {
+    tasks.push_back(pool.submit([this, stream, &entry, output]() {
+      const stream_T* begin = stream + entry.offset;
+      decoder_.decode(begin, begin + entry.size, output, entry.numSymbols);
+    }));
+    output += entry.numSymbols;
+  }
+  waitAll(tasks);
+}
+
+}  // namespace rans
@@ -0,0 +1,140 @@
+/*
+ * BlockEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "EncodedBlocks.h"
+#include "Encoder.h"
+#include "OutputBuffer.h"
+#include "SymbolStatistics.h"
+#include "ThreadPool.h"
+
+namespace rans {
+
+// Splits [begin, end) into blocks of blockSize symbols, codes them on pool
+// and concatenates the results. encodeBlock(block, blockBegin, blockEnd,
+// bufferBegin, bufferEnd) codes one block with an Encoder<coder_T, stream_T,
+// N> at probabilityBits backwards into the buffer and returns the start of
+// its stream. The scratch buffers of the blocks are leased from arena.
+template <typename coder_T, typename stream_T, size_t N, typename source_IT,
+          typename F>
+EncodedBlocks<stream_T> encodeBlocks(source_IT begin, source_IT end,
+                                     size_t blockSize,
+                                     size_t probabilityBits, ThreadPool& pool,
+                                     OutputArena<stream_T>& arena,
+                                     F&& encodeBlock) {
+  const size_t numSymbols = end - begin;
+  const size_t numBlocks = (numSymbols + blockSize - 1) / blockSize;
+  auto blockLength = [&](size_t block) {
+    return std::min(blockSize, numSymbols - block * blockSize);
+  };
+
+  // every block is coded backwards into its own scratch buffer ...
+  std::vector<typename OutputArena<stream_T>::Lease> leases;
+  leases.reserve(numBlocks);
+  for (size_t block = 0; block < numBlocks; block++) {
+    leases.push_back(arena.acquire(maxCompressedSize<coder_T, stream_T, N>(
+        blockLength(block), probabilityBits)));
+  }
+  std::vector<stream_T*> blockBegins(numBlocks);
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(numBlocks);
+  for (size_t block = 0; block < numBlocks; block++) {
+    tasks.push_back(pool.submit([&, block]() {
+      const source_IT blockBegin = begin + block * blockSize;
+      const source_IT blockEnd = blockBegin + blockLength(block);
+      OutputBuffer<stream_T>& buffer = *leases[block];
+      blockBegins[block] = encodeBlock(block, blockBegin, blockEnd,
+                                       buffer.begin(), buffer.end());
+    }));
+  }
+  waitAll(tasks);
+
+  // ... and then copied into place behind its predecessors.
+  EncodedBlocks<stream_T> encoded;
+  encoded.index.resize(numBlocks);
+  uint64_t offset = 0;
+  for (size_t block = 0; block < numBlocks; block++) {
+    auto& entry = encoded.index[block];
+    entry.offset = offset;
+    entry.size = leases[block]->end() - blockBegins[block];
+    entry.numSymbols = blockLength(block);
+    offset += entry.size;
+  }
+  encoded.stream.resize(offset);
+
+  tasks.clear();
+  for (size_t block = 0; block < numBlocks; block++) {
+    tasks.push_back(pool.submit([&, block]() {
+      const auto& entry = encoded.index[block];
+      std::memcpy(encoded.stream.data() + entry.offset, blockBegins[block],
+                  entry.size * sizeof(stream_T));
+    }));
+  }
+  waitAll(tasks);
+  return encoded;
+}
+
+// Splits the input into blocks of blockSize symbols and codes each of them
+// with its own N interleaved states on a thread pool. All blocks share the
+// symbol table of one Encoder, and the scratch buffers of the blocks are
+// reused across calls to encode.
+template <typename coder_T, typename stream_T, size_t N>
+class BlockEncoder {
+ public:
+  BlockEncoder(const SymbolStatistics& stats, size_t probabilityBits,
+               size_t blockSize);
+
+  // [begin, end) may be any random access iterators.
+  template <typename source_IT>
+  EncodedBlocks<stream_T> encode(source_IT begin, source_IT end,
+                                 ThreadPool& pool) const;
+
+  size_t getBlockSize() const;
+
+ private:
+  size_t blockSize_;
+  size_t probabilityBits_;
+  Encoder<coder_T, stream_T, N> encoder_;
+  mutable OutputArena<stream_T> arena_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+BlockEncoder<coder_T, stream_T, N>::BlockEncoder(const SymbolStatistics& stats,
+                                                 size_t probabilityBits,
+                                                 size_t blockSize)
+    : blockSize_(blockSize),
+      probabilityBits_(probabilityBits),
+      encoder_(stats, probabilityBits) {
+  if (blockSize_ == 0) {
+    throw std::runtime_error("block size must not be 0");
+  }
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+EncodedBlocks<stream_T> BlockEncoder<coder_T, stream_T, N>::encode(
+    source_IT begin, source_IT end, ThreadPool& pool) const {
+  return encodeBlocks<coder_T, stream_T, N>(
+      begin, end, blockSize_, probabilityBits_, pool, arena_,
+      [this](size_t, source_IT blockBegin, source_IT blockEnd,
+             stream_T* bufferBegin, stream_T* bufferEnd) {
+        return encoder_.encode(blockBegin, blockEnd, bufferBegin, bufferEnd);
+      });
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+size_t BlockEncoder<coder_T, stream_T, N>::getBlockSize() const {
+  return blockSize_;
+}
+
+}  // namespace rans
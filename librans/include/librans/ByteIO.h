@@ -0,0 +1,148 @@
+/*
+ * ByteIO.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace rans {
+
+// Maps signed to unsigned values such that small magnitudes stay small.
+inline uint64_t zigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+}
+
+inline int64_t zigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Appends little endian integers and varints to a byte buffer.
+class ByteWriter {
+ public:
+  explicit ByteWriter(std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+  template <typename T>
+  void put(T value) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+      buffer_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+
+  void putVarint(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    buffer_.push_back(static_cast<uint8_t>(value));
+  }
+
+  void putZigZag(int64_t value) { putVarint(zigZagEncode(value)); }
+
+  // Writes values as varints. Every 0 is followed by the varint number of 0s
+  // that directly follow it, so long gaps cost a few bytes.
+  void putRunLengthVarints(const std::vector<uint64_t>& values) {
+    uint64_t zeros = 0;
+    for (const uint64_t value : values) {
+      if (value == 0 && zeros > 0) {
+        zeros++;
+        continue;
+      }
+      if (zeros > 0) {
+        putVarint(zeros - 1);
+        zeros = 0;
+      }
+      putVarint(value);
+      zeros = value == 0;
+    }
+    if (zeros > 0) {
+      putVarint(zeros - 1);
+    }
+  }
+
+ private:
+  std::vector<uint8_t>& buffer_;
+};
+
+// Reads what ByteWriter wrote, throwing on truncated or malformed input.
+class ByteReader {
+ public:
+  ByteReader(const uint8_t* data, size_t size)
+      : pos_(data), end_(data + size) {}
+
+  template <typename T>
+  T get() {
+    require(sizeof(T));
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+      value |= static_cast<T>(*pos_++) << (8 * i);
+    }
+    return value;
+  }
+
+  uint64_t getVarint() {
+    uint64_t value = 0;
+    for (size_t shift = 0; shift < 64; shift += 7) {
+      require(1);
+      const uint8_t byte = *pos_++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    throw std::runtime_error("corrupt data: varint too long");
+  }
+
+  int64_t getZigZag() { return zigZagDecode(getVarint()); }
+
+  // Reads numValues values written by ByteWriter::putRunLengthVarints,
+  // throwing on values that do not fit into value_T.
+  template <typename value_T = uint64_t>
+  std::vector<value_T> getRunLengthVarints(size_t numValues) {
+    std::vector<value_T> values;
+    // a run of zeros can stand for any number of values, so only reserve what
+    // the remaining bytes could hold one value per byte.
+    values.reserve(std::min(numValues, remaining()));
+    while (values.size() < numValues) {
+      const uint64_t value = getVarint();
+      if (value > std::numeric_limits<value_T>::max()) {
+        throw std::runtime_error("corrupt data: value out of range");
+      }
+      values.push_back(static_cast<value_T>(value));
+      if (value == 0) {
+        const uint64_t zeros = getVarint();
+        if (zeros > numValues - values.size()) {
+          throw std::runtime_error("corrupt data: run length overflow");
+        }
+        values.resize(values.size() + zeros, 0);
+      }
+    }
+    return values;
+  }
+
+  void require(size_t bytes) const {
+    if (static_cast<size_t>(end_ - pos_) < bytes) {
+      throw std::runtime_error("corrupt data: truncated");
+    }
+  }
+
+  void skip(size_t bytes) {
+    require(bytes);
+    pos_ += bytes;
+  }
+
+  const uint8_t* position() const { return pos_; }
+  size_t remaining() const { return end_ - pos_; }
+
+ private:
+  const uint8_t* pos_;
+  const uint8_t* end_;
+};
+
+}  // namespace rans
@@ -6,10 +6,13 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 #include <cassert>
 
+#include "AliasEncoderSymbol.h"
 #include "DecoderSymbol.h"
 #include "EncoderSymbol.h"
 #include "helper.h"
@@ -83,10 +86,10 @@ public:
 		T x = *r;
 		Stream_t* ptr = *pptr;
 
-		if constexpr (needs64Bit<T>()){
+		if constexpr (needs64Bit<T>() || isWordStream<Stream_t>()){
 		    ptr -= 2;
 		    ptr[0] = static_cast<Stream_t> (x >> 0);
-		    ptr[1] = static_cast<Stream_t> (x >> 32);
+		    ptr[1] = static_cast<Stream_t> (x >> STREAM_BITS_);
 		}
 		else
 		{
@@ -100,6 +103,35 @@ public:
 		*pptr = ptr;
 	};
 
+	// Upper bound on the words a single state emits for numSymbols symbols,
+	// its flush included.
+	//
+	// A renormalization never emits more than ceil(scale_bits / STREAM_BITS_)
+	// words. Over a whole stream the bound is tighter: coding a symbol of
+	// frequency freq grows the state by less than
+	// log2((1 << scale_bits) / freq) + log2(1 + (1 << scale_bits) / L) bits,
+	// every emitted word takes STREAM_BITS_ bits off it, and the state starts
+	// at L and never ends up below it.
+	static constexpr size_t encMaxWords(size_t numSymbols, uint32_t scale_bits)
+	{
+		const size_t perStep = numSymbols * ((scale_bits + STREAM_BITS_ - 1) / STREAM_BITS_);
+		if (scale_bits > LOWER_BOUND_BITS_) {
+			return perStep + FLUSH_WORDS_;
+		}
+		// log2(1 + a) < 1.5 a
+		const size_t shift = LOWER_BOUND_BITS_ + 1 - scale_bits;
+		const size_t excessBits = (3 * numSymbols + (size_t(1) << shift) - 1) >> shift;
+		const size_t amortized = (numSymbols * scale_bits + excessBits) / STREAM_BITS_;
+		return std::min(perStep, amortized) + FLUSH_WORDS_;
+	};
+
+	// Largest scale_bits the coder supports, frequencies of up to
+	// 1 << scale_bits have to fit below L.
+	static constexpr uint32_t maxScaleBits()
+	{
+		return LOWER_BOUND_BITS_;
+	};
+
 	// Initializes a rANS decoder.
 	// Unlike the encoder, the decoder works forwards as you'd expect.
 	static void decInit(State<T>* r, Stream_t** pptr)
@@ -107,9 +139,9 @@ public:
 		T x;
 		Stream_t* ptr = *pptr;
 
-		if constexpr (needs64Bit<T>()){
+		if constexpr (needs64Bit<T>() || isWordStream<Stream_t>()){
 		    x  = static_cast<T> (ptr[0]) << 0;
-		    x |= static_cast<T> (ptr[1]) << 32;
+		    x |= static_cast<T> (ptr[1]) << STREAM_BITS_;
 		    ptr += 2;
 		}
 		else
@@ -126,6 +158,29 @@ public:
 	};
 
 
+	// decInit for streams from untrusted input. Returns false unless the state
+	// fits before end and lies in [L, 2^bits), where every encoder flushes it.
+	// Decoding keeps it there, so decRenorm never takes more than
+	// decMaxRenormWords() words afterwards.
+	static bool decInitChecked(State<T>* r, Stream_t** pptr, const Stream_t* end)
+	{
+		if (end - *pptr < static_cast<ptrdiff_t>(FLUSH_WORDS_)) {
+			return false;
+		}
+		decInit(r, pptr);
+		return *r >= LOWER_BOUND_;
+	};
+
+	// Largest number of words decRenorm takes for a state set up by decInitChecked.
+	static constexpr size_t decMaxRenormWords()
+	{
+		if constexpr (needs64Bit<T>() || isSingleWordStep()) {
+			return 1;
+		} else {
+			return (LOWER_BOUND_BITS_ + STREAM_BITS_ - 1) / STREAM_BITS_;
+		}
+	};
+
 	// Returns the current cumulative frequency (map it to a symbol yourself!)
 	static uint32_t decGet(State<T>* r, uint32_t scale_bits)
 	{
@@ -153,14 +208,15 @@ public:
 	// multiplications instead of a divide.
 	//
 	// See Rans32EncSymbolInit for a description of how this works.
-	static void encPutSymbol(State<T>* r, Stream_t** pptr, EncoderSymbol<T> const* sym, uint32_t scale_bits)
+	// scale_bits is folded into the symbol, including its renormalization bound x_max.
+	static void encPutSymbol(State<T>* r, Stream_t** pptr, EncoderSymbol<T> const* sym, uint32_t /*scale_bits*/)
 	{
 #ifdef DEBUG
 		assert(sym->freq != 0); // can't encode symbol with freq=0
 #endif
 
 		// renormalize
-		T x = encRenorm(*r,pptr,sym->freq,scale_bits);
+		T x = encRenormTo(*r,pptr,sym->x_max);
 
 		// x = C(s,x)
 		T q;
@@ -179,6 +235,16 @@ public:
 		*r = x + sym->bias + q * sym->cmpl_freq;
 	};
 
+	// Encodes a symbol through an alias table. Instead of start + x % freq, the
+	// remainder picks one of the slots owned by the symbol.
+	static void encPutSymbol(State<T>* r, Stream_t** pptr, AliasEncoderSymbol<T> const* sym, uint32_t scale_bits)
+	{
+		encPutSymbol(r, pptr, &sym->symbol, scale_bits);
+
+		const uint32_t remainder = *r & ((1u << scale_bits) - 1);
+		*r = *r - remainder + sym->slots[remainder];
+	};
+
 	// Equivalent to Rans32DecAdvance that takes a symbol.
 	static void decAdvanceSymbol(State<T>* r, Stream_t** pptr, DecoderSymbol const* sym, uint32_t scale_bits)
 	{
@@ -208,7 +274,16 @@ public:
 	{
 		// renormalize
 		T x = *r;
-		if (x < LOWER_BOUND_) {
+		if constexpr (isSingleWordStep()) {
+			// Branchless, see encRenormTo. Without a word to take, the word in front of
+			// ptr is read instead, which keeps the load inside the stream: decInit
+			// consumed the state before any renormalization.
+			const bool renorm = x < LOWER_BOUND_;
+			Stream_t* ptr = *pptr;
+			const T next = (x << STREAM_BITS_) | ptr[static_cast<ptrdiff_t>(renorm) - 1];
+			x = renorm ? next : x;
+			*pptr = ptr + renorm;
+		} else if (x < LOWER_BOUND_) {
 			if constexpr(needs64Bit<T>())
 			{
 				x = (x << STREAM_BITS_) | **pptr;
@@ -225,13 +300,50 @@ public:
 		*r = x;
 	}
 
+	// decRenorm that never reads at or past end. Returns false if it would have to.
+	static inline bool decRenormChecked(State<T>* r, Stream_t** pptr, const Stream_t* end)
+	{
+		T x = *r;
+		Stream_t* ptr = *pptr;
+		while (x < LOWER_BOUND_) {
+			if (ptr == end) {
+				return false;
+			}
+			x = (x << STREAM_BITS_) | *ptr++;
+			if constexpr (needs64Bit<T>() || isSingleWordStep()) {
+				break;
+			}
+		}
+		*pptr = ptr;
+		*r = x;
+		return true;
+	}
+
 private:
 
 	// Renormalize the encoder.
 	static inline State<T> encRenorm(State<T> x, Stream_t** pptr, uint32_t freq, uint32_t scale_bits)
 	{
 		T x_max = ((LOWER_BOUND_ >> scale_bits) << STREAM_BITS_) * freq; // this turns into a shift.
-		if (x >= x_max) {
+		return encRenormTo(x, pptr, x_max);
+	};
+
+	// Renormalize the encoder against a precomputed bound, e.g. EncoderSymbol::x_max.
+	static inline State<T> encRenormTo(State<T> x, Stream_t** pptr, T x_max)
+	{
+		static_assert((LOWER_BOUND_ << STREAM_BITS_) == (T(1) << (sizeof(T) * 8 - 1)), "EncoderSymbol::x_max assumes L << STREAM_BITS = 2^(bits of T - 1)");
+		if constexpr (isSingleWordStep()) {
+			// At most one word, so renormalization is a conditional move instead of a
+			// branch that mispredicts on skewed data: the word is always stored in front
+			// of ptr, but ptr only moves over it if it is emitted. Otherwise the next
+			// word or the flush overwrites it, so there has to be room for one word,
+			// which there is for any buffer that can take the flush.
+			const bool emit = x >= x_max;
+			Stream_t* ptr = *pptr;
+			ptr[-1] = static_cast<Stream_t>(x);
+			*pptr = ptr - emit;
+			x = emit ? (x >> STREAM_BITS_) : x;
+		} else if (x >= x_max) {
 			if constexpr(needs64Bit<T>())
 			{
 				*pptr -= 1;
@@ -240,7 +352,7 @@ private:
 			}else{
 				Stream_t* ptr = *pptr;
 				do {
-					*--ptr = static_cast<Stream_t> (x & 0xff);
+					*--ptr = static_cast<Stream_t> (x);
 					x >>= STREAM_BITS_;
 				} while (x >= x_max);
 				*pptr = ptr;
@@ -253,9 +365,24 @@ private:
 	// Between this and our byte-aligned emission, we use 31 (not 32!) bits.
 	// This is done intentionally because exact reciprocals for 31-bit uints
 	// fit in 32-bit uints: this permits some optimizations during encoding.
-	inline static constexpr T LOWER_BOUND_ = needs64Bit<T>()? (1u << 31) :(1u << 23); // lower bound of our normalization interval
+	//
+	// A 32 bit state with 16 bit word I/O uses L = 2^15 instead, which keeps
+	// the same 31 bits, limits scale_bits to 15 and is the layout of the SIMD
+	// decoders: a state never needs more than a single word to renormalize
+	// and the states of 8 lanes fit into one AVX2 register.
+	inline static constexpr T LOWER_BOUND_ = needs64Bit<T>()? (1u << 31) : isWordStream<Stream_t>()? (1u << 15) :(1u << 23); // lower bound of our normalization interval
 
 	inline static constexpr T STREAM_BITS_ = sizeof(Stream_t)*8; // lower bound of our normalization interval
 
+	inline static constexpr uint32_t LOWER_BOUND_BITS_ = needs64Bit<T>()? 31 : isWordStream<Stream_t>()? 15 : 23;
+
+	inline static constexpr size_t FLUSH_WORDS_ = (needs64Bit<T>() || isWordStream<Stream_t>())? 2 : 4; // words written by encFlush
+
+	// A 32 bit state with 16 bit words never moves more than one word per renormalization.
+	static constexpr bool isSingleWordStep()
+	{
+		return !needs64Bit<T>() && isWordStream<Stream_t>();
+	};
+
 };
 } // namespace rans
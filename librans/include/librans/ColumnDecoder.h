@@ -0,0 +1,100 @@
+/*
+ * ColumnDecoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "ColumnFrame.h"
+#include "Decoder.h"
+
+namespace rans {
+
+// Decodes columns of a ColumnFrame written by ColumnEncoder<coder_T, stream_T,
+// N>. Decoder tables are only built for the selected columns, and decoding a
+// column only reads its own part of the payload.
+template <typename coder_T, typename stream_T, size_t N>
+class ColumnDecoder {
+ public:
+  // All columns of frame.
+  explicit ColumnDecoder(const ColumnFrame& frame);
+
+  // Only the given columns of frame. The payload of frame is read in place,
+  // so the buffer holding the frame has to outlive the decoder.
+  ColumnDecoder(const ColumnFrame& frame, const std::vector<size_t>& columns);
+
+  size_t getNumSymbols(size_t column) const;
+
+  // Writes the getNumSymbols(column) symbols of a selected column to output,
+  // which may be any random access iterator. Different columns can be decoded
+  // concurrently. Throws instead of reading past the end of the column.
+  template <typename source_IT>
+  void decode(size_t column, source_IT output) const;
+
+ private:
+  const stream_T* payload_;
+  std::vector<uint8_t> sourceBytes_;
+  std::vector<BlockIndexEntry> entries_;
+  std::vector<std::unique_ptr<Decoder<coder_T, stream_T, N>>> decoders_;
+};
+
+namespace internal {
+inline std::vector<size_t> allColumns(const ColumnFrame& frame) {
+  std::vector<size_t> columns(frame.getNumColumns());
+  std::iota(columns.begin(), columns.end(), 0);
+  return columns;
+}
+}  // namespace internal
+
+template <typename coder_T, typename stream_T, size_t N>
+ColumnDecoder<coder_T, stream_T, N>::ColumnDecoder(const ColumnFrame& frame)
+    : ColumnDecoder(frame, internal::allColumns(frame)) {}
+
+template <typename coder_T, typename stream_T, size_t N>
+ColumnDecoder<coder_T, stream_T, N>::ColumnDecoder(
+    const ColumnFrame& frame, const std::vector<size_t>& columns)
+    : payload_(frame.getPayload<stream_T>()),
+      sourceBytes_(frame.getNumColumns()),
+      entries_(frame.getNumColumns()),
+      decoders_(frame.getNumColumns()) {
+  frame.checkCoder<coder_T, stream_T, N>();
+  for (const size_t column : columns) {
+    const ColumnInfo& info = frame.getColumn(column);
+    sourceBytes_[column] = info.sourceBytes;
+    entries_[column] = info.entry;
+    decoders_[column] = std::make_unique<Decoder<coder_T, stream_T, N>>(
+        info.stats, info.probabilityBits);
+  }
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+size_t ColumnDecoder<coder_T, stream_T, N>::getNumSymbols(
+    size_t column) const {
+  return entries_.at(column).numSymbols;
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+void ColumnDecoder<coder_T, stream_T, N>::decode(size_t column,
+                                                 source_IT output) const {
+  if (column >= decoders_.size() || !decoders_[column]) {
+    throw std::runtime_error("column was not selected for decoding");
+  }
+  if (sourceBytes_[column] !=
+      sizeof(typename std::iterator_traits<source_IT>::value_type)) {
+    throw std::runtime_error("source type does not match column");
+  }
+  const BlockIndexEntry& entry = entries_[column];
+  const stream_T* begin = payload_ + entry.offset;
+  decoders_[column]->decode(begin, begin + entry.size, output,
+                            entry.numSymbols);
+}
+
+}  // namespace rans
@@ -0,0 +1,134 @@
+/*
+ * ColumnEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "ColumnFrame.h"
+#include "Encoder.h"
+#include "Histogram.h"
+#include "OutputBuffer.h"
+#include "SymbolStatistics.h"
+#include "ThreadPool.h"
+
+namespace rans {
+
+// Codes many independent columns, e.g. the fields of a record, each with its
+// own dictionary, into a single ColumnFrame.
+//
+// Symbol tables are built once when a column is added and reused for every
+// call to encode, as are the scratch buffers the columns are coded into. The
+// columns of one call are coded concurrently on a pool, each with N
+// interleaved states, and land in one frame with an offset per column, so
+// ColumnDecoder can decode any subset of them.
+template <typename coder_T, typename stream_T, size_t N>
+class ColumnEncoder {
+ public:
+  // Adds the next column; columns are numbered in the order they are added.
+  void addColumn(const SymbolStatistics& stats, size_t probabilityBits);
+
+  size_t getNumColumns() const;
+
+  // One range per column, in the order the columns were added. Ranges only
+  // need begin() and end() returning random access iterators, so fields can
+  // be coded in place through fieldOf.
+  template <typename... range_T>
+  std::vector<uint8_t> encode(ThreadPool& pool,
+                              const range_T&... columns) const;
+
+ private:
+  using Lease = typename OutputArena<stream_T>::Lease;
+
+  template <typename source_IT>
+  std::future<void> encodeColumn(ThreadPool& pool, size_t column,
+                                 source_IT begin, source_IT end,
+                                 OutputBuffer<stream_T>& buffer,
+                                 BlockIndexEntry& entry) const;
+
+  std::vector<ColumnInfo> columns_;
+  std::vector<Encoder<coder_T, stream_T, N>> encoders_;
+  mutable OutputArena<stream_T> arena_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+void ColumnEncoder<coder_T, stream_T, N>::addColumn(
+    const SymbolStatistics& stats, size_t probabilityBits) {
+  encoders_.emplace_back(stats, probabilityBits);
+  columns_.push_back({static_cast<uint8_t>(probabilityBits), 0, stats, {}});
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+size_t ColumnEncoder<coder_T, stream_T, N>::getNumColumns() const {
+  return columns_.size();
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename... range_T>
+std::vector<uint8_t> ColumnEncoder<coder_T, stream_T, N>::encode(
+    ThreadPool& pool, const range_T&... columns) const {
+  if (sizeof...(columns) != columns_.size()) {
+    throw std::runtime_error("number of columns does not match encoder");
+  }
+
+  // every column is coded backwards into its own scratch buffer ...
+  std::vector<BlockIndexEntry> entries(columns_.size());
+  std::vector<Lease> leases;
+  leases.reserve(columns_.size());
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(columns_.size());
+  size_t column = 0;
+  ((leases.push_back(arena_.acquire(maxCompressedSize<coder_T, stream_T, N>(
+        columns.end() - columns.begin(), columns_[column].probabilityBits))),
+    column++),
+   ...);
+  column = 0;
+  ((tasks.push_back(encodeColumn(pool, column, columns.begin(), columns.end(),
+                                 *leases[column], entries[column])),
+    column++),
+   ...);
+  waitAll(tasks);
+
+  // ... and then copied straight into the payload of the frame, behind its
+  // predecessors.
+  uint64_t offset = 0;
+  for (auto& entry : entries) {
+    entry.offset = offset;
+    offset += entry.size;
+  }
+  const uint8_t sourceBytes[] = {
+      sizeof(token_t<decltype(columns.begin())>)...};
+  std::vector<uint8_t> frame =
+      ColumnFrame::serialize<coder_T, stream_T, N>(columns_, sourceBytes,
+                                                   entries);
+  uint8_t* payload = frame.data() + frame.size() - offset * sizeof(stream_T);
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (entries[i].size > 0) {
+      std::memcpy(payload + entries[i].offset * sizeof(stream_T),
+                  leases[i]->end() - entries[i].size,
+                  entries[i].size * sizeof(stream_T));
+    }
+  }
+  return frame;
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+std::future<void> ColumnEncoder<coder_T, stream_T, N>::encodeColumn(
+    ThreadPool& pool, size_t column, source_IT begin, source_IT end,
+    OutputBuffer<stream_T>& buffer, BlockIndexEntry& entry) const {
+  entry.numSymbols = end - begin;
+  return pool.submit([this, column, begin, end, &buffer, &entry]() {
+    const stream_T* streamBegin =
+        encoders_[column].encode(begin, end, buffer.begin(), buffer.end());
+    entry.size = buffer.end() - streamBegin;
+  });
+}
+
+}  // namespace rans
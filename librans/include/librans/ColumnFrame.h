@@ -0,0 +1,119 @@
+/*
+ * ColumnFrame.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Coder.h"
+#include "EncodedBlocks.h"
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// A column: its dictionary and the position of its stream in the payload.
+struct ColumnInfo {
+  uint8_t probabilityBits;
+  uint8_t sourceBytes;  // size of a source symbol
+  SymbolStatistics stats;
+  BlockIndexEntry entry;
+};
+
+// Self-describing container for columns coded by ColumnEncoder.
+//
+// Layout, all integers little endian:
+//
+//   magic "rANC" | header | columns | padding | payload
+//
+// - header: version (uint16_t), coder bits and stream word bytes (uint8_t
+//   each), interleaved states per column (uint16_t) and the number of
+//   columns (varint).
+// - columns: per column its probability bits and source bytes (uint8_t
+//   each), its dictionary in the format of Frame and {offset, size,
+//   numSymbols} as uint64_t, in stream words relative to the payload.
+// - payload: the concatenated column streams in native stream words,
+//   aligned to 8 bytes relative to the start of the frame.
+//
+// The payload is read in place; since every column has its own offset, a
+// reader only touches the streams of the columns it decodes.
+class ColumnFrame {
+ public:
+  inline static constexpr uint16_t VERSION = 1;
+
+  ColumnFrame(const uint8_t* data, size_t size);
+
+  // The frame of columns, with sourceBytes and entries in place of their own,
+  // but without their streams: the payload is left as the last
+  // getPayloadSize(entries) words of the buffer, for the caller to write the
+  // stream of every column in place at the offset of its entry.
+  template <typename coder_T, typename stream_T, size_t N>
+  static std::vector<uint8_t> serialize(
+      const std::vector<ColumnInfo>& columns, const uint8_t* sourceBytes,
+      const std::vector<BlockIndexEntry>& entries);
+
+  // Stream words of consecutive entries.
+  static size_t getPayloadSize(const std::vector<BlockIndexEntry>& entries);
+
+  size_t getNumColumns() const;
+  const ColumnInfo& getColumn(size_t column) const;
+
+  // Throws unless the frame was written by the given coder configuration, with
+  // probability bits the coder supports in every column.
+  template <typename coder_T, typename stream_T, size_t N>
+  void checkCoder() const;
+
+  template <typename stream_T>
+  const stream_T* getPayload() const;
+
+ private:
+  static std::vector<uint8_t> serialize(
+      uint8_t coderBits, uint8_t streamBytes, uint16_t numLanes,
+      const std::vector<ColumnInfo>& columns, const uint8_t* sourceBytes,
+      const std::vector<BlockIndexEntry>& entries, size_t payloadBytes);
+
+  uint8_t coderBits_;
+  uint8_t streamBytes_;
+  uint16_t numLanes_;
+  std::vector<ColumnInfo> columns_;
+  const uint8_t* payload_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+std::vector<uint8_t> ColumnFrame::serialize(
+    const std::vector<ColumnInfo>& columns, const uint8_t* sourceBytes,
+    const std::vector<BlockIndexEntry>& entries) {
+  return serialize(sizeof(coder_T) * 8, sizeof(stream_T), N, columns,
+                   sourceBytes, entries,
+                   getPayloadSize(entries) * sizeof(stream_T));
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+void ColumnFrame::checkCoder() const {
+  if (coderBits_ != sizeof(coder_T) * 8 || streamBytes_ != sizeof(stream_T) ||
+      numLanes_ != N) {
+    throw std::runtime_error("frame was written by a different coder");
+  }
+  for (const ColumnInfo& column : columns_) {
+    if (column.probabilityBits > Coder<coder_T, stream_T>::maxScaleBits()) {
+      throw std::runtime_error("corrupt frame: invalid probability bits");
+    }
+  }
+}
+
+template <typename stream_T>
+const stream_T* ColumnFrame::getPayload() const {
+  if (streamBytes_ != sizeof(stream_T)) {
+    throw std::runtime_error("stream word size does not match frame");
+  }
+  if (reinterpret_cast<uintptr_t>(payload_) % alignof(stream_T)) {
+    throw std::runtime_error("frame payload is not aligned");
+  }
+  return reinterpret_cast<const stream_T*>(payload_);
+}
+
+}  // namespace rans
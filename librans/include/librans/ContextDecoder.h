@@ -0,0 +1,120 @@
+/*
+ * ContextDecoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Coder.h"
+#include "ContextStatistics.h"
+#include "Decoder.h"
+#include "DecoderTable.h"
+#include "FixedScaleCoder.h"
+
+namespace rans {
+
+// Decodes a stream written by ContextEncoder<coder_T, stream_T, N>.
+//
+// A DecoderTable per context would need 1 << probabilityBits entries each.
+// Instead every table only lists its symbols with nonzero frequency, sorted
+// by start, and the symbol owning a slot is found by a branch free binary
+// search. All tables are stored back to back in table order, and every
+// context maps directly to the range of its table.
+template <typename coder_T, typename stream_T, size_t N>
+class ContextDecoder {
+  static_assert(N > 0, "need at least one state");
+
+ public:
+  // Throws if the probability bits of stats are more than the coder
+  // supports.
+  explicit ContextDecoder(const ContextStatistics& stats);
+
+  // Decodes numSymbols symbols from the stream starting at input into output.
+  template <typename source_IT>
+  void decode(const stream_T* input, source_IT output,
+              size_t numSymbols) const;
+
+ private:
+  using Rans = Coder<coder_T, stream_T>;
+
+  struct TableRange {
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  inline const DecoderTableEntry& find(int previous, uint32_t slot) const;
+
+  size_t probabilityBits_;
+  int min_;
+  size_t contextShift_;
+  // first level: per context, the entries of its table.
+  std::vector<TableRange> contextTables_;
+  // second level: all tables.
+  std::vector<DecoderTableEntry> entries_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+ContextDecoder<coder_T, stream_T, N>::ContextDecoder(
+    const ContextStatistics& stats)
+    : probabilityBits_(stats.getProbabilityBits()),
+      min_(stats.minSymbol()),
+      contextShift_(stats.getContextShift()) {
+  if (probabilityBits_ > Rans::maxScaleBits()) {
+    throw std::runtime_error("context model has too many probability bits");
+  }
+  std::vector<TableRange> tables;
+  for (size_t index = 0; index < stats.getNumTables(); index++) {
+    const SymbolStatistics& table = stats.getTable(index);
+    TableRange range{static_cast<uint32_t>(entries_.size()), 0};
+    int symbol = table.minSymbol();
+    for (const auto& entry : table) {
+      if (entry.first > 0) {
+        entries_.push_back({symbol, entry.second, entry.first});
+        range.size++;
+      }
+      symbol++;
+    }
+    tables.push_back(range);
+  }
+  for (size_t context = 0; context < stats.getNumContexts(); context++) {
+    contextTables_.push_back(tables[stats.getTableIndex(context)]);
+  }
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+inline const DecoderTableEntry& ContextDecoder<coder_T, stream_T, N>::find(
+    int previous, uint32_t slot) const {
+  const TableRange& table =
+      contextTables_[static_cast<size_t>(previous - min_) >> contextShift_];
+  const DecoderTableEntry* entry = entries_.data() + table.offset;
+  for (uint32_t size = table.size; size > 1;) {
+    const uint32_t half = size / 2;
+    entry = entry[half].start <= slot ? entry + half : entry;
+    size -= half;
+  }
+  return *entry;
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+void ContextDecoder<coder_T, stream_T, N>::decode(const stream_T* input,
+                                                  source_IT output,
+                                                  size_t numSymbols) const {
+  const RuntimeScaleCoder<coder_T, stream_T> coder(probabilityBits_);
+  int previous = min_;
+  decodeInterleaved<coder_T, N>(
+      coder, input, numSymbols, [&](State<coder_T>* state) {
+        const DecoderTableEntry& entry = find(previous, coder.decGet(state));
+        *output++ = entry.symbol;
+        previous = entry.symbol;
+        coder.decAdvanceStep(state, entry.start, entry.freq);
+      });
+}
+
+}  // namespace rans
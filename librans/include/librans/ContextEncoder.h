@@ -0,0 +1,129 @@
+/*
+ * ContextEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "Coder.h"
+#include "ContextStatistics.h"
+#include "Encoder.h"
+#include "EncoderSymbol.h"
+
+namespace rans {
+
+// Encodes a range of symbols with N interleaved rANS states, coding every
+// symbol with the table of its order-1 context, see ContextStatistics. The
+// layout of states and symbols is the one of Encoder.
+//
+// The EncoderSymbols of all tables are stored back to back in table order, so
+// the tables of the hot contexts share a few cache lines, and every context
+// maps directly to the offset of its table.
+template <typename coder_T, typename stream_T, size_t N>
+class ContextEncoder {
+  static_assert(N > 0, "need at least one state");
+
+ public:
+  // Throws if the probability bits of stats are more than the coder
+  // supports.
+  explicit ContextEncoder(const ContextStatistics& stats);
+
+  // Encodes [begin,end) into the buffer [outputBegin,outputEnd). The stream is
+  // written backwards from outputEnd, the return value is its start. Throws
+  // unless every symbol has a nonzero frequency in the table of its context,
+  // which for a model trained on other data need not be the case.
+  template <typename source_IT>
+  stream_T* encode(const source_IT begin, const source_IT end,
+                   stream_T* outputBegin, stream_T* outputEnd) const;
+
+ private:
+  using Rans = Coder<coder_T, stream_T>;
+
+  struct TableRange {
+    uint32_t offset;
+    uint32_t size;
+    int min;
+  };
+
+  inline const EncoderSymbol<coder_T>* getSymbol(int previous,
+                                                 int symbol) const;
+
+  size_t probabilityBits_;
+  int min_;
+  int max_;
+  size_t contextShift_;
+  // first level: per context, the symbols of its table, starting at min.
+  std::vector<TableRange> contextTables_;
+  // second level: all tables.
+  std::vector<EncoderSymbol<coder_T>> symbols_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+ContextEncoder<coder_T, stream_T, N>::ContextEncoder(
+    const ContextStatistics& stats)
+    : probabilityBits_(stats.getProbabilityBits()),
+      min_(stats.minSymbol()),
+      max_(stats.maxSymbol()),
+      contextShift_(stats.getContextShift()) {
+  if (probabilityBits_ > Rans::maxScaleBits()) {
+    throw std::runtime_error("context model has too many probability bits");
+  }
+  std::vector<TableRange> tableRanges;
+  for (size_t index = 0; index < stats.getNumTables(); index++) {
+    const SymbolStatistics& table = stats.getTable(index);
+    tableRanges.push_back({static_cast<uint32_t>(symbols_.size()),
+                           static_cast<uint32_t>(table.size()),
+                           table.minSymbol()});
+    for (const auto& entry : table) {
+      symbols_.emplace_back(entry.second, entry.first, probabilityBits_);
+    }
+  }
+  for (size_t context = 0; context < stats.getNumContexts(); context++) {
+    contextTables_.push_back(tableRanges[stats.getTableIndex(context)]);
+  }
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+inline const EncoderSymbol<coder_T>*
+ContextEncoder<coder_T, stream_T, N>::getSymbol(int previous,
+                                                int symbol) const {
+  // previous is coded after symbol, so it has not been checked yet.
+  if (previous < min_ || previous > max_) {
+    throw std::runtime_error("symbol not covered by context model");
+  }
+  const size_t context =
+      static_cast<size_t>(static_cast<int64_t>(previous) - min_) >>
+      contextShift_;
+  const TableRange& table = contextTables_[context];
+  const int64_t index = static_cast<int64_t>(symbol) - table.min;
+  if (index < 0 || index >= table.size ||
+      symbols_[table.offset + index].freq == 0) {
+    throw std::runtime_error("symbol not covered by context model");
+  }
+  return &symbols_[table.offset + index];
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+stream_T* ContextEncoder<coder_T, stream_T, N>::encode(
+    const source_IT begin, const source_IT end, stream_T* outputBegin,
+    stream_T* outputEnd) const {
+  // it points behind the next symbol to code, its predecessor is the context.
+  source_IT it = end;
+  return encodeInterleaved<coder_T, N>(
+      std::distance(begin, end), outputBegin, outputEnd,
+      [&](State<coder_T>* state, stream_T** pptr) {
+        --it;
+        const int previous = it == begin ? min_ : *std::prev(it);
+        Rans::encPutSymbol(state, pptr, getSymbol(previous, *it),
+                           probabilityBits_);
+      });
+}
+
+}  // namespace rans
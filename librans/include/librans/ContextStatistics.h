@@ -0,0 +1,115 @@
+/*
+ * ContextStatistics.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Histogram.h"
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Order-1 statistics: the distribution of a symbol depends on its
+// predecessor. The first symbol is predicted as if minSymbol() preceded it.
+//
+// Contexts are the previous symbol - minSymbol(), shifted right by
+// getContextShift() so there are at most 1 << MAX_CONTEXT_BITS of them. Only
+// contexts whose estimated saving over the order-0 distribution pays for
+// their own table get one; all other contexts share the fallback table built
+// from the symbols following them. Lookups are two-level: context to table
+// index, then the table. Tables are numbered by decreasing use, so the hot
+// ones come first in the layouts of ContextEncoder and ContextDecoder.
+class ContextStatistics {
+ public:
+  inline static constexpr size_t MAX_CONTEXT_BITS = 10;
+  inline static constexpr size_t MAX_SYMBOL_RANGE = 1 << 24;
+  // Largest number of frequencies in all tables together.
+  inline static constexpr size_t MAX_MODEL_SIZE = 4 * MAX_SYMBOL_RANGE;
+
+  // At most maxTables tables, the fallback table included.
+  template <typename source_IT>
+  ContextStatistics(source_IT begin, source_IT end, size_t probabilityBits,
+                    size_t maxTables = 1 << MAX_CONTEXT_BITS);
+
+  // From a range of tokens, e.g. a std::vector, Span or StridedSpan.
+  template <typename range_T,
+            typename = decltype(std::declval<const range_T&>().begin())>
+  ContextStatistics(const range_T& tokens, size_t probabilityBits,
+                    size_t maxTables = 1 << MAX_CONTEXT_BITS)
+      : ContextStatistics(tokens.begin(), tokens.end(), probabilityBits,
+                          maxTables) {}
+
+  // From the output of serialize().
+  ContextStatistics(const uint8_t* data, size_t size);
+
+  // Compact binary form: tables as run length coded varints, see ByteWriter.
+  std::vector<uint8_t> serialize() const;
+
+  size_t getProbabilityBits() const;
+
+  int minSymbol() const;
+  int maxSymbol() const;
+
+  size_t getContextShift() const;
+  size_t getNumContexts() const;
+
+  // Context of a symbol following previous.
+  inline size_t getContext(int previous) const;
+
+  inline size_t getTableIndex(size_t context) const;
+
+  // Table 0 is the fallback table.
+  size_t getNumTables() const;
+  const SymbolStatistics& getTable(size_t index) const;
+
+ private:
+  // symbols holds every token - min.
+  void build(const std::vector<uint32_t>& symbols, size_t maxTables);
+
+  size_t probabilityBits_;
+  int min_ = 0;
+  int max_ = 0;
+  size_t contextShift_ = 0;
+  std::vector<uint32_t> tableIndices_;
+  std::vector<SymbolStatistics> tables_;
+};
+
+template <typename source_IT>
+ContextStatistics::ContextStatistics(source_IT begin, source_IT end,
+                                     size_t probabilityBits, size_t maxTables)
+    : probabilityBits_(probabilityBits) {
+  if (begin == end) {
+    throw std::runtime_error("no tokens to build statistics from");
+  }
+  const auto range = tokenRange(begin, end);
+  if (static_cast<int64_t>(range.second) - range.first >=
+      static_cast<int64_t>(MAX_SYMBOL_RANGE)) {
+    throw std::runtime_error("symbol range too large for context model");
+  }
+  min_ = range.first;
+  max_ = range.second;
+
+  std::vector<uint32_t> symbols;
+  symbols.reserve(end - begin);
+  for (source_IT it = begin; it != end; ++it) {
+    symbols.push_back(static_cast<int64_t>(*it) - min_);
+  }
+  build(symbols, maxTables);
+}
+
+inline size_t ContextStatistics::getContext(int previous) const {
+  return static_cast<size_t>(previous - min_) >> contextShift_;
+}
+
+inline size_t ContextStatistics::getTableIndex(size_t context) const {
+  return tableIndices_[context];
+}
+
+}  // namespace rans
@@ -0,0 +1,184 @@
+/*
+ * Decoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AliasTable.h"
+#include "Coder.h"
+#include "DecoderTable.h"
+#include "FixedScaleCoder.h"
+#include "SymbolStatistics.h"
+#include "helper.h"
+
+namespace rans {
+
+// Decodes numSymbols symbols from a stream written by encodeInterleaved that
+// starts at input. decodeSymbol(state) is called once per symbol, in order,
+// and has to decode it from state without renormalizing: coder, e.g. one
+// passed by withScaleCoder, renormalizes a whole group of states afterwards.
+template <typename coder_T, size_t N, typename scaleCoder_T,
+          typename stream_T, typename F>
+void decodeInterleaved(const scaleCoder_T& coder, const stream_T* input,
+                       size_t numSymbols, F&& decodeSymbol) {
+  static_assert(N > 0, "need at least one state");
+  State<coder_T> states[N];
+  // the Coder API takes mutable stream pointers, but decoding only reads.
+  stream_T* ptr = const_cast<stream_T*>(input);
+  unroll<N>([&](auto lane) { coder.decInit(&states[lane], &ptr); });
+
+  for (size_t i = 0; i < numSymbols / N; i++) {
+    unroll<N>([&](auto lane) { decodeSymbol(&states[lane]); });
+    unroll<N>([&](auto lane) { coder.decRenorm(&states[lane], &ptr); });
+  }
+
+  // incomplete last group on the first states
+  const size_t tail = numSymbols % N;
+  for (size_t lane = 0; lane < tail; lane++) {
+    decodeSymbol(&states[lane]);
+  }
+  for (size_t lane = 0; lane < tail; lane++) {
+    coder.decRenorm(&states[lane], &ptr);
+  }
+}
+
+// Decodes a stream written by Encoder<coder_T, stream_T, N>.
+//
+// decoderTable_T maps a slot to a DecoderTableEntry, see DecoderTable. The
+// decoding loop runs on a FixedScaleCoder for the common probability bit
+// counts, see withScaleCoder. Like Encoder, the constructors throw if the
+// probability bits exceed Coder<coder_T, stream_T>::maxScaleBits().
+template <typename coder_T, typename stream_T, size_t N,
+          typename decoderTable_T = DecoderTable>
+class Decoder {
+  static_assert(N > 0, "need at least one state");
+
+ public:
+  Decoder(const SymbolStatistics& stats, size_t probabilityBits);
+
+  // Uses a ready built decoder table, e.g. a view into a BinaryDictionary.
+  explicit Decoder(decoderTable_T decoderTable);
+
+  // Decodes numSymbols symbols from the stream starting at input into output.
+  template <typename source_IT>
+  void decode(const stream_T* input, source_IT output,
+              size_t numSymbols) const;
+
+  // Same, for a stream from untrusted input that ends at end. Throws instead
+  // of reading at or past end.
+  template <typename source_IT>
+  void decode(const stream_T* begin, const stream_T* end, source_IT output,
+              size_t numSymbols) const;
+
+ private:
+  // checked before the decoder table is built for them.
+  static size_t checkedProbabilityBits(size_t probabilityBits);
+
+  size_t probabilityBits_;
+  decoderTable_T decoderTable_;
+};
+
+// Decodes a stream written by AliasEncoder<coder_T, stream_T, N>.
+template <typename coder_T, typename stream_T, size_t N>
+using AliasDecoder = Decoder<coder_T, stream_T, N, AliasTable>;
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename decoderTable_T>
+Decoder<coder_T, stream_T, N, decoderTable_T>::Decoder(
+    const SymbolStatistics& stats, size_t probabilityBits)
+    : probabilityBits_(checkedProbabilityBits(probabilityBits)),
+      decoderTable_(stats, probabilityBits) {}
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename decoderTable_T>
+Decoder<coder_T, stream_T, N, decoderTable_T>::Decoder(
+    decoderTable_T decoderTable)
+    : probabilityBits_(
+          checkedProbabilityBits(decoderTable.getProbabilityBits())),
+      decoderTable_(std::move(decoderTable)) {}
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename decoderTable_T>
+size_t Decoder<coder_T, stream_T, N, decoderTable_T>::checkedProbabilityBits(
+    size_t probabilityBits) {
+  if (probabilityBits > Coder<coder_T, stream_T>::maxScaleBits()) {
+    throw std::runtime_error("too many probability bits for the coder");
+  }
+  return probabilityBits;
+}
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename decoderTable_T>
+template <typename source_IT>
+void Decoder<coder_T, stream_T, N, decoderTable_T>::decode(
+    const stream_T* input, source_IT output, size_t numSymbols) const {
+  decoderTable_.visit([&](const auto& decoderTable) {
+    withScaleCoder<coder_T, stream_T>(probabilityBits_, [&](auto coder) {
+      decodeInterleaved<coder_T, N>(
+          coder, input, numSymbols, [&](State<coder_T>* state) {
+            const DecoderTableEntry entry = decoderTable[coder.decGet(state)];
+            *output++ = entry.symbol;
+            coder.decAdvanceStep(state, entry.start, entry.freq);
+          });
+    });
+  });
+}
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename decoderTable_T>
+template <typename source_IT>
+void Decoder<coder_T, stream_T, N, decoderTable_T>::decode(
+    const stream_T* begin, const stream_T* end, source_IT output,
+    size_t numSymbols) const {
+  // a group of N renormalizations that can not run past end is not checked.
+  constexpr ptrdiff_t GROUP_WORDS =
+      N * Coder<coder_T, stream_T>::decMaxRenormWords();
+  decoderTable_.visit([&](const auto& decoderTable) {
+    withScaleCoder<coder_T, stream_T>(probabilityBits_, [&](auto coder) {
+      State<coder_T> states[N];
+      stream_T* ptr = const_cast<stream_T*>(begin);
+      unroll<N>([&](auto lane) {
+        if (!coder.decInitChecked(&states[lane], &ptr, end)) {
+          throw std::runtime_error("corrupt data: invalid stream");
+        }
+      });
+
+      auto decodeSymbol = [&](State<coder_T>* state) {
+        const DecoderTableEntry entry = decoderTable[coder.decGet(state)];
+        *output++ = entry.symbol;
+        coder.decAdvanceStep(state, entry.start, entry.freq);
+      };
+      auto renormChecked = [&](State<coder_T>* state) {
+        if (!coder.decRenormChecked(state, &ptr, end)) {
+          throw std::runtime_error("corrupt data: truncated stream");
+        }
+      };
+
+      for (size_t i = 0; i < numSymbols / N; i++) {
+        unroll<N>([&](auto lane) { decodeSymbol(&states[lane]); });
+        if (end - ptr >= GROUP_WORDS) {
+          unroll<N>([&](auto lane) { coder.decRenorm(&states[lane], &ptr); });
+        } else {
+          unroll<N>([&](auto lane) { renormChecked(&states[lane]); });
+        }
+      }
+
+      const size_t tail = numSymbols % N;
+      for (size_t lane = 0; lane < tail; lane++) {
+        decodeSymbol(&states[lane]);
+      }
+      for (size_t lane = 0; lane < tail; lane++) {
+        renormChecked(&states[lane]);
+      }
+    });
+  });
+}
+
+}  // namespace rans
@@ -0,0 +1,146 @@
+/*
+ * DecoderTable.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Everything the decoder needs to know about the symbol owning a slot.
+struct DecoderTableEntry {
+  int symbol;
+  uint32_t start;
+  uint32_t freq;
+};
+
+// Read only view of a packed table. Every entry holds, from the lowest bit
+// upwards, freq - 1 and start in probabilityBits each and symbol - min in the
+// remaining bits, so a decoded symbol costs one load.
+template <typename packed_T>
+class PackedDecoderTable {
+ public:
+  PackedDecoderTable(const packed_T* table, uint32_t probabilityBits, int min)
+      : table_(table),
+        probabilityBits_(probabilityBits),
+        mask_((static_cast<packed_T>(1) << probabilityBits) - 1),
+        min_(min){};
+
+  inline DecoderTableEntry operator[](uint32_t slot) const {
+    const packed_T entry = table_[slot];
+    return {static_cast<int>(entry >> (2 * probabilityBits_)) + min_,
+            static_cast<uint32_t>((entry >> probabilityBits_) & mask_),
+            static_cast<uint32_t>(entry & mask_) + 1};
+  }
+
+ private:
+  const packed_T* table_;
+  uint32_t probabilityBits_;
+  packed_T mask_;
+  int min_;
+};
+
+// Non owning view of the packed entries of a DecoderTable, e.g. stored in a
+// BinaryDictionary.
+class DecoderTableView {
+ public:
+  DecoderTableView(const void* table, bool packed32, uint32_t probabilityBits,
+                   int min)
+      : table_(table),
+        packed32_(packed32),
+        probabilityBits_(probabilityBits),
+        min_(min){};
+
+  bool isPacked32() const { return packed32_; }
+
+  size_t getProbabilityBits() const { return probabilityBits_; }
+
+  int getMinSymbol() const { return min_; }
+
+  const void* data() const { return table_; }
+
+  size_t sizeBytes() const {
+    return (static_cast<size_t>(1) << probabilityBits_) *
+           (packed32_ ? sizeof(uint32_t) : sizeof(uint64_t));
+  }
+
+  template <typename F>
+  decltype(auto) visit(F&& f) const;
+
+  inline DecoderTableEntry operator[](uint32_t slot) const;
+
+ private:
+  const void* table_;
+  bool packed32_;
+  uint32_t probabilityBits_;
+  int min_;
+};
+
+// Maps each of the 1 << probabilityBits slots directly to the symbol owning it
+// together with its start and frequency. This fuses the cumulative -> symbol
+// table and the DecoderSymbol table, which otherwise need two dependent loads
+// per decoded symbol.
+//
+// Entries are packed into 32 bit if 2 * probabilityBits plus the bits of the
+// symbol range fit, into 64 bit otherwise.
+class DecoderTable {
+ public:
+  DecoderTable(const SymbolStatistics& stats, size_t probabilityBits);
+
+  // Whether entries of entryBytes hold numSymbols symbols at probabilityBits,
+  // with the symbol shift below the width of the entry.
+  static bool canPack(size_t entryBytes, size_t numSymbols,
+                      size_t probabilityBits);
+
+  bool isPacked32() const;
+
+  size_t getProbabilityBits() const;
+
+  // Calls f with the PackedDecoderTable matching the packing of this table,
+  // so the choice is made once per call and not once per symbol.
+  template <typename F>
+  decltype(auto) visit(F&& f) const;
+
+  DecoderTableEntry operator[](uint32_t slot) const;
+
+  DecoderTableView getView() const;
+
+ private:
+  template <typename packed_T>
+  static std::vector<packed_T> build(const SymbolStatistics& stats,
+                                     size_t probabilityBits);
+
+  uint32_t probabilityBits_;
+  int min_;
+  std::vector<uint32_t> packed32_;
+  std::vector<uint64_t> packed64_;
+};
+
+template <typename F>
+decltype(auto) DecoderTableView::visit(F&& f) const {
+  if (packed32_) {
+    return f(PackedDecoderTable<uint32_t>(
+        static_cast<const uint32_t*>(table_), probabilityBits_, min_));
+  } else {
+    return f(PackedDecoderTable<uint64_t>(
+        static_cast<const uint64_t*>(table_), probabilityBits_, min_));
+  }
+}
+
+inline DecoderTableEntry DecoderTableView::operator[](uint32_t slot) const {
+  return visit([slot](const auto& table) { return table[slot]; });
+}
+
+template <typename F>
+decltype(auto) DecoderTable::visit(F&& f) const {
+  return getView().visit(std::forward<F>(f));
+}
+
+}  // namespace rans
@@ -0,0 +1,44 @@
+/*
+ * EncodedBlocks.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace rans {
+
+// Position of one independently coded block inside a concatenated stream.
+struct BlockIndexEntry {
+  uint64_t offset;      // first stream word of the block
+  uint64_t size;        // stream words of the block
+  uint64_t numSymbols;  // symbols coded in the block
+};
+
+// Independently coded blocks, concatenated in input order, plus the index
+// needed to decode them in parallel.
+template <typename stream_T>
+struct EncodedBlocks {
+  std::vector<stream_T> stream;
+  std::vector<BlockIndexEntry> index;
+
+  uint64_t numSymbols() const {
+    uint64_t numSymbols = 0;
+    for (const auto& block : index) {
+      numSymbols += block.numSymbols;
+    }
+    return numSymbols;
+  }
+};
+
+// Blocks coded with a table per block, see AdaptiveDictionary.
+template <typename stream_T>
+struct EncodedAdaptiveBlocks {
+  EncodedBlocks<stream_T> blocks;
+  std::vector<uint8_t> tableUpdates;  // one update per block, in block order
+};
+
+}  // namespace rans
@@ -0,0 +1,25 @@
+/*
+ * EncodedSparse.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace rans {
+
+// Output of SparseEncoder: the rANS coded indices and, in input order, the raw
+// bits of every escaped value, packed into 64 bit words starting at the lowest
+// bit.
+template <typename stream_T>
+struct EncodedSparse {
+  std::vector<stream_T> stream;
+  std::vector<uint64_t> escapes;
+  uint64_t numSymbols = 0;
+  uint64_t numEscapes = 0;
+};
+
+}  // namespace rans
@@ -0,0 +1,146 @@
+/*
+ * Encoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "AliasTable.h"
+#include "Coder.h"
+#include "EncoderSymbol.h"
+#include "SymbolStatistics.h"
+#include "SymbolTable.h"
+#include "helper.h"
+
+namespace rans {
+
+// Codes numSymbols symbols with N interleaved rANS states into the buffer
+// [outputBegin,outputEnd), in the layout described at Encoder, and returns the
+// start of the stream. encodeSymbol(state, pptr) is called once per symbol,
+// last symbol first, and has to code that symbol into state.
+template <typename coder_T, size_t N, typename stream_T, typename F>
+stream_T* encodeInterleaved(size_t numSymbols, stream_T* outputBegin,
+                            stream_T* outputEnd, F&& encodeSymbol) {
+  static_assert(N > 0, "need at least one state");
+  using Rans = Coder<coder_T, stream_T>;
+  // a symbol never emits more words than the state is wide.
+  constexpr size_t MAX_WORDS_PER_SYMBOL = sizeof(coder_T) / sizeof(stream_T);
+  const size_t tail = numSymbols % N;
+
+  State<coder_T> states[N];
+  for (auto& state : states) {
+    Rans::encInit(&state);
+  }
+
+  stream_T* ptr = outputEnd;
+  auto checkSpace = [&](size_t words) {
+    if (ptr - outputBegin < static_cast<ptrdiff_t>(words)) {
+      throw std::runtime_error("output buffer too small");
+    }
+  };
+
+  // incomplete last group is coded by the first states
+  checkSpace(tail * MAX_WORDS_PER_SYMBOL);
+  for (size_t lane = tail; lane > 0; lane--) {
+    encodeSymbol(&states[lane - 1], &ptr);
+  }
+
+  for (size_t i = numSymbols - tail; i > 0;
+       i -= N) {  // NB: working in reverse!
+    checkSpace(N * MAX_WORDS_PER_SYMBOL);
+    unrollReverse<N>([&](auto lane) { encodeSymbol(&states[lane], &ptr); });
+  }
+
+  checkSpace(N * MAX_WORDS_PER_SYMBOL);
+  unrollReverse<N>([&](auto lane) { Rans::encFlush(&states[lane], &ptr); });
+  return ptr;
+}
+
+// Encodes a range of symbols with N interleaved rANS states.
+//
+// Symbol i is coded by state i % N. A trailing group of fewer than N symbols is
+// coded by the first states, and states are flushed last to first so the
+// decoder finds them in order at the start of the stream. For
+// Encoder<uint32_t, uint16_t, 8> this is exactly the layout read by
+// SIMDDecoder.
+//
+// symbolTable_T maps a symbol to whatever Coder::encPutSymbol takes, by
+// default the EncoderSymbol read by Decoder. The constructors throw if
+// probabilityBits exceeds Coder<coder_T, stream_T>::maxScaleBits().
+template <typename coder_T, typename stream_T, size_t N,
+          typename symbolTable_T = SymbolTable<EncoderSymbol<coder_T>>>
+class Encoder {
+  static_assert(N > 0, "need at least one state");
+
+ public:
+  Encoder(const SymbolStatistics& stats, size_t probabilityBits);
+
+  // Uses a ready built symbol table, e.g. a view into a BinaryDictionary.
+  Encoder(symbolTable_T symbolTable, size_t probabilityBits);
+
+  // Encodes [begin,end) into the buffer [outputBegin,outputEnd). The stream is
+  // written backwards from outputEnd, the return value is its start.
+  template <typename source_IT>
+  stream_T* encode(const source_IT begin, const source_IT end,
+                   stream_T* outputBegin, stream_T* outputEnd) const;
+
+ private:
+  using Rans = Coder<coder_T, stream_T>;
+
+  // checked before the symbol table is built for them.
+  static size_t checkedProbabilityBits(size_t probabilityBits);
+
+  size_t probabilityBits_;
+  symbolTable_T symbolTable_;
+};
+
+// Writes the slot layout of an AliasTable, decode with AliasDecoder.
+template <typename coder_T, typename stream_T, size_t N>
+using AliasEncoder = Encoder<coder_T, stream_T, N, AliasSymbolTable<coder_T>>;
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename symbolTable_T>
+Encoder<coder_T, stream_T, N, symbolTable_T>::Encoder(
+    const SymbolStatistics& stats, size_t probabilityBits)
+    : probabilityBits_(checkedProbabilityBits(probabilityBits)),
+      symbolTable_(stats, probabilityBits) {}
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename symbolTable_T>
+Encoder<coder_T, stream_T, N, symbolTable_T>::Encoder(
+    symbolTable_T symbolTable, size_t probabilityBits)
+    : probabilityBits_(checkedProbabilityBits(probabilityBits)),
+      symbolTable_(std::move(symbolTable)) {}
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename symbolTable_T>
+size_t Encoder<coder_T, stream_T, N, symbolTable_T>::checkedProbabilityBits(
+    size_t probabilityBits) {
+  if (probabilityBits > Rans::maxScaleBits()) {
+    throw std::runtime_error("too many probability bits for the coder");
+  }
+  return probabilityBits;
+}
+
+template <typename coder_T, typename stream_T, size_t N,
+          typename symbolTable_T>
+template <typename source_IT>
+stream_T* Encoder<coder_T, stream_T, N, symbolTable_T>::encode(
+    const source_IT begin, const source_IT end, stream_T* outputBegin,
+    stream_T* outputEnd) const {
+  source_IT it = end;
+  return encodeInterleaved<coder_T, N>(
+      std::distance(begin, end), outputBegin, outputEnd,
+      [&](State<coder_T>* state, stream_T** pptr) {
+        --it;
+        Rans::encPutSymbol(state, pptr, &symbolTable_[*it], probabilityBits_);
+      });
+}
+
+}  // namespace rans
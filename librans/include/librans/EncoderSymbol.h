@@ -46,6 +46,10 @@ struct EncoderSymbol
 
 		this->freq = freq;
 		this->cmpl_freq = static_cast<T>((1 << scale_bits) - freq);
+		// The encoder renormalizes while x >= ((L >> scale_bits) << STREAM_BITS) * freq.
+		// L << STREAM_BITS is 1 << (bits of T - 1) for every supported Coder, so the bound
+		// depends on the symbol only.
+		this->x_max = static_cast<T>(freq) << (sizeof(T) * 8 - 1 - scale_bits);
 		if (freq < 2) {
 			// freq=0 symbols are never valid to encode, so it doesn't matter what
 			// we set our values to.
@@ -113,6 +117,7 @@ struct EncoderSymbol
 	uint32_t bias;      // Bias
 	uint32_t cmpl_freq; // Complement of frequency: (1 << scale_bits) - freq
 	uint32_t rcp_shift; // Reciprocal shift
+	T x_max;            // Renormalization bound: freq << (bits of T - 1 - scale_bits)
 };
 
 }//namespace rans
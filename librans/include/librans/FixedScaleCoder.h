@@ -0,0 +1,152 @@
+/*
+ * FixedScaleCoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "AliasEncoderSymbol.h"
+#include "Coder.h"
+#include "EncoderSymbol.h"
+#include "helper.h"
+
+namespace rans {
+
+// Coder<T, Stream_t> with scale_bits fixed at compile time. The stream is the
+// same, but the slot mask and the shifts of the step functions are
+// immediates instead of being rebuilt from scale_bits for every symbol.
+//
+// The members are static, objects only exist to be passed to the functors of
+// withScaleCoder.
+template <typename T, typename Stream_t, uint32_t ScaleBits>
+class FixedScaleCoder {
+  using Rans = Coder<T, Stream_t>;
+  static_assert(ScaleBits > 0 && ScaleBits <= Rans::maxScaleBits(),
+                "scale bits not supported by the coder");
+
+ public:
+  static constexpr uint32_t SCALE_BITS = ScaleBits;
+
+  static void encInit(State<T>* r) { Rans::encInit(r); }
+
+  static void encPutSymbol(State<T>* r, Stream_t** pptr,
+                           const EncoderSymbol<T>* sym) {
+    Rans::encPutSymbol(r, pptr, sym, ScaleBits);
+  }
+
+  static void encPutSymbol(State<T>* r, Stream_t** pptr,
+                           const AliasEncoderSymbol<T>* sym) {
+    Rans::encPutSymbol(r, pptr, sym, ScaleBits);
+  }
+
+  static void encFlush(State<T>* r, Stream_t** pptr) {
+    Rans::encFlush(r, pptr);
+  }
+
+  static void decInit(State<T>* r, Stream_t** pptr) { Rans::decInit(r, pptr); }
+
+  static bool decInitChecked(State<T>* r, Stream_t** pptr,
+                             const Stream_t* end) {
+    return Rans::decInitChecked(r, pptr, end);
+  }
+
+  static uint32_t decGet(const State<T>* r) {
+    return static_cast<uint32_t>(*r & MASK_);
+  }
+
+  static void decAdvanceStep(State<T>* r, uint32_t start, uint32_t freq) {
+    const T x = *r;
+    *r = freq * (x >> ScaleBits) + (x & MASK_) - start;
+  }
+
+  static void decRenorm(State<T>* r, Stream_t** pptr) {
+    Rans::decRenorm(r, pptr);
+  }
+
+  static bool decRenormChecked(State<T>* r, Stream_t** pptr,
+                               const Stream_t* end) {
+    return Rans::decRenormChecked(r, pptr, end);
+  }
+
+ private:
+  inline static constexpr T MASK_ = (T(1) << ScaleBits) - 1;
+};
+
+// The interface of FixedScaleCoder with scale_bits taken at run time, for
+// the bit counts withScaleCoder does not specialize.
+template <typename T, typename Stream_t>
+class RuntimeScaleCoder {
+  using Rans = Coder<T, Stream_t>;
+
+ public:
+  explicit RuntimeScaleCoder(uint32_t scaleBits) : scaleBits_(scaleBits) {}
+
+  void encInit(State<T>* r) const { Rans::encInit(r); }
+
+  void encPutSymbol(State<T>* r, Stream_t** pptr,
+                    const EncoderSymbol<T>* sym) const {
+    Rans::encPutSymbol(r, pptr, sym, scaleBits_);
+  }
+
+  void encPutSymbol(State<T>* r, Stream_t** pptr,
+                    const AliasEncoderSymbol<T>* sym) const {
+    Rans::encPutSymbol(r, pptr, sym, scaleBits_);
+  }
+
+  void encFlush(State<T>* r, Stream_t** pptr) const { Rans::encFlush(r, pptr); }
+
+  void decInit(State<T>* r, Stream_t** pptr) const { Rans::decInit(r, pptr); }
+
+  bool decInitChecked(State<T>* r, Stream_t** pptr,
+                      const Stream_t* end) const {
+    return Rans::decInitChecked(r, pptr, end);
+  }
+
+  uint32_t decGet(const State<T>* r) const {
+    return static_cast<uint32_t>(*r & ((T(1) << scaleBits_) - 1));
+  }
+
+  void decAdvanceStep(State<T>* r, uint32_t start, uint32_t freq) const {
+    Rans::decAdvanceStep(r, start, freq, scaleBits_);
+  }
+
+  void decRenorm(State<T>* r, Stream_t** pptr) const {
+    Rans::decRenorm(r, pptr);
+  }
+
+  bool decRenormChecked(State<T>* r, Stream_t** pptr,
+                        const Stream_t* end) const {
+    return Rans::decRenormChecked(r, pptr, end);
+  }
+
+ private:
+  uint32_t scaleBits_;
+};
+
+// Probability bit counts withScaleCoder instantiates a FixedScaleCoder for.
+// Every one is a copy of the calling loop, so only the commonly used ones are
+// specialized.
+inline constexpr uint32_t MIN_FIXED_SCALE_BITS = 12;
+inline constexpr uint32_t MAX_FIXED_SCALE_BITS = 20;
+
+// Calls f(FixedScaleCoder<T, Stream_t, scaleBits>{}) if scaleBits is in
+// [MIN_FIXED_SCALE_BITS, MAX_FIXED_SCALE_BITS] and supported by the coder,
+// f(RuntimeScaleCoder<T, Stream_t>{scaleBits}) otherwise.
+template <typename T, typename Stream_t, typename F>
+void withScaleCoder(uint32_t scaleBits, F&& f) {
+  constexpr uint32_t MAX_BITS =
+      std::min(MAX_FIXED_SCALE_BITS, Coder<T, Stream_t>::maxScaleBits());
+  const bool isFixed = withScaleBits<MIN_FIXED_SCALE_BITS, MAX_BITS>(
+      scaleBits, [&](auto bits) {
+        f(FixedScaleCoder<T, Stream_t, decltype(bits)::value>{});
+      });
+  if (!isFixed) {
+    f(RuntimeScaleCoder<T, Stream_t>(scaleBits));
+  }
+}
+
+}  // namespace rans
@@ -0,0 +1,143 @@
+/*
+ * Frame.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "ByteIO.h"
+#include "Coder.h"
+#include "EncodedBlocks.h"
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Largest number of symbols in a dictionary. Dictionaries are dense, so this
+// bounds the memory a dictionary read from untrusted input can take.
+inline constexpr size_t MAX_DICTIONARY_SIZE = size_t(1) << 24;
+
+// Dictionaries as stored in frames: the varint size in bytes, the minimal
+// symbol (zigzag varint), the number of symbols (varint) and the normalized
+// frequencies as run length coded varints, see ByteWriter.
+void writeDictionary(ByteWriter& writer, const SymbolStatistics& stats);
+
+// Throws unless the frequencies sum up to 1 << probabilityBits and the
+// symbols are ints that fit the alphabet of a source of sourceBytes bytes:
+// [0, 2^(8 * sourceBytes)) for sources narrower than an int.
+SymbolStatistics readDictionary(ByteReader& reader, size_t probabilityBits,
+                                size_t sourceBytes);
+
+// Everything needed to set up a decoder for a frame.
+struct FrameHeader {
+  uint16_t version;
+  uint8_t coderBits;        // width of the rANS state: 32 or 64
+  uint8_t streamBytes;      // size of a stream word
+  uint8_t probabilityBits;  // frequencies sum up to 1 << probabilityBits
+  uint8_t sourceBytes;      // size of a source symbol
+  uint16_t numLanes;        // interleaved states per block
+  uint64_t numSymbols;
+  uint64_t numBlocks;
+};
+
+// Self-describing container for block coded data.
+//
+// Layout, all integers little endian:
+//
+//   magic "rANS" | header | dictionary | block index | padding | payload
+//
+// - header: the fields of FrameHeader in declaration order, packed.
+// - dictionary: varint size in bytes, the minimal symbol (zigzag varint), the
+//   number of symbols (varint) and the normalized frequencies as varints.
+//   Every zero frequency is followed by the varint number of zero frequencies
+//   that directly follow it, so gaps in sparse alphabets cost a few bytes.
+// - block index: numBlocks times {offset, size, numSymbols} as uint64_t, in
+//   stream words relative to the start of the payload.
+// - payload: the concatenated block streams in native stream words, aligned
+//   to 8 bytes relative to the start of the frame.
+//
+// A Frame parses and validates header, dictionary and index; the payload is
+// not copied and is read in place from the buffer passed to the constructor.
+class Frame {
+ public:
+  inline static constexpr uint16_t VERSION = 1;
+
+  Frame(const uint8_t* data, size_t size);
+
+  template <typename coder_T, typename stream_T, size_t N, typename source_T>
+  static std::vector<uint8_t> serialize(const SymbolStatistics& stats,
+                                        size_t probabilityBits,
+                                        const EncodedBlocks<stream_T>& blocks);
+
+  const FrameHeader& getHeader() const;
+  const SymbolStatistics& getSymbolStatistics() const;
+  const std::vector<BlockIndexEntry>& getBlockIndex() const;
+
+  // Throws unless the frame was written by the given coder configuration from
+  // source_T symbols, with probability bits the coder supports.
+  template <typename coder_T, typename stream_T, size_t N, typename source_T>
+  void checkCoder() const;
+
+  template <typename stream_T>
+  const stream_T* getPayload() const;
+
+ private:
+  static std::vector<uint8_t> serialize(
+      const FrameHeader& header, const SymbolStatistics& stats,
+      const std::vector<BlockIndexEntry>& index, const void* payload,
+      size_t payloadBytes);
+
+  FrameHeader header_;
+  std::unique_ptr<SymbolStatistics> stats_;
+  std::vector<BlockIndexEntry> index_;
+  const uint8_t* payload_;
+  size_t payloadBytes_;
+};
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+std::vector<uint8_t> Frame::serialize(const SymbolStatistics& stats,
+                                      size_t probabilityBits,
+                                      const EncodedBlocks<stream_T>& blocks) {
+  const FrameHeader header{VERSION,
+                           sizeof(coder_T) * 8,
+                           sizeof(stream_T),
+                           static_cast<uint8_t>(probabilityBits),
+                           sizeof(source_T),
+                           N,
+                           blocks.numSymbols(),
+                           blocks.index.size()};
+  return serialize(header, stats, blocks.index, blocks.stream.data(),
+                   blocks.stream.size() * sizeof(stream_T));
+}
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+void Frame::checkCoder() const {
+  if (header_.coderBits != sizeof(coder_T) * 8 ||
+      header_.streamBytes != sizeof(stream_T) || header_.numLanes != N) {
+    throw std::runtime_error("frame was written by a different coder");
+  }
+  if (header_.probabilityBits > Coder<coder_T, stream_T>::maxScaleBits()) {
+    throw std::runtime_error("corrupt frame: invalid probability bits");
+  }
+  if (header_.sourceBytes != sizeof(source_T)) {
+    throw std::runtime_error("source type does not match frame");
+  }
+}
+
+template <typename stream_T>
+const stream_T* Frame::getPayload() const {
+  if (header_.streamBytes != sizeof(stream_T)) {
+    throw std::runtime_error("stream word size does not match frame");
+  }
+  if (reinterpret_cast<uintptr_t>(payload_) % alignof(stream_T)) {
+    throw std::runtime_error("frame payload is not aligned");
+  }
+  return reinterpret_cast<const stream_T*>(payload_);
+}
+
+}  // namespace rans
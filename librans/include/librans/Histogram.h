@@ -0,0 +1,178 @@
+/*
+ * Histogram.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace rans {
+
+// Counting tokens one after the other into a single table stalls whenever the
+// same value repeats: every increment has to wait for the store of the
+// previous one. Consecutive tokens are therefore counted into
+// HISTOGRAM_SUBTABLES independent tables that are summed at the end, as long
+// as the extra tables stay small.
+constexpr size_t HISTOGRAM_SUBTABLES = 4;
+constexpr size_t HISTOGRAM_MAX_SUBTABLE_SIZE = 1 << 16;
+
+// Inputs are only split across threads in chunks of at least this many tokens,
+// and of at least as many tokens as the histogram has entries.
+constexpr size_t HISTOGRAM_MIN_CHUNK_SIZE = 1 << 16;
+
+// Whether a histogram over every value of T is small enough to count without
+// knowing min and max first.
+template <typename T>
+constexpr bool isNarrowSource() {
+  return std::numeric_limits<T>::is_integer && sizeof(T) <= 2;
+}
+
+// Token ranges are given by random access iterators, e.g. pointers or the
+// StridedIterators over one field of an array of structs.
+template <typename source_IT>
+using token_t = typename std::iterator_traits<source_IT>::value_type;
+
+// Adds the frequencies of tokens in [min, min + size) to frequencies. All
+// tokens have to lie in this range.
+template <typename source_IT>
+void countTokens(source_IT begin, source_IT end, int64_t min,
+                 uint32_t* frequencies, size_t size) {
+  using T = token_t<source_IT>;
+  const size_t numTokens = end - begin;
+  auto index = [min](T token) {
+    return static_cast<size_t>(static_cast<int64_t>(token) - min);
+  };
+
+  if (size > HISTOGRAM_MAX_SUBTABLE_SIZE || numTokens < HISTOGRAM_SUBTABLES * size) {
+    for (source_IT it = begin; it != end; ++it) {
+      frequencies[index(*it)]++;
+    }
+    return;
+  }
+
+  std::vector<uint32_t> subtables((HISTOGRAM_SUBTABLES - 1) * size, 0);
+  uint32_t* tables[HISTOGRAM_SUBTABLES] = {frequencies};
+  for (size_t i = 1; i < HISTOGRAM_SUBTABLES; i++) {
+    tables[i] = subtables.data() + (i - 1) * size;
+  }
+
+  source_IT it = begin;
+  for (; end - it >= static_cast<ptrdiff_t>(HISTOGRAM_SUBTABLES);
+       it += HISTOGRAM_SUBTABLES) {
+    for (size_t i = 0; i < HISTOGRAM_SUBTABLES; i++) {
+      tables[i][index(it[i])]++;
+    }
+  }
+  for (; it != end; ++it) {
+    frequencies[index(*it)]++;
+  }
+
+  for (size_t i = 1; i < HISTOGRAM_SUBTABLES; i++) {
+    for (size_t j = 0; j < size; j++) {
+      frequencies[j] += tables[i][j];
+    }
+  }
+}
+
+// Number of chunks to split numTokens tokens into for a histogram of size
+// entries.
+inline size_t histogramChunks(size_t numTokens, size_t size,
+                              const ThreadPool* pool) {
+  if (pool == nullptr) {
+    return 1;
+  }
+  const size_t chunkSize = std::max(HISTOGRAM_MIN_CHUNK_SIZE, size);
+  return std::max<size_t>(1, std::min(pool->size(), numTokens / chunkSize));
+}
+
+// Smallest and largest token of a non empty range.
+template <typename source_IT>
+std::pair<token_t<source_IT>, token_t<source_IT>> tokenRange(
+    source_IT begin, source_IT end, ThreadPool* pool = nullptr) {
+  using T = token_t<source_IT>;
+  auto minmax = [](source_IT first, source_IT last) {
+    const auto result = std::minmax_element(first, last);
+    return std::make_pair(*result.first, *result.second);
+  };
+
+  const size_t numTokens = end - begin;
+  const size_t numChunks = histogramChunks(numTokens, 0, pool);
+  if (numChunks == 1) {
+    return minmax(begin, end);
+  }
+
+  std::vector<std::pair<T, T>> partials(numChunks);
+  std::vector<std::future<void>> tasks;
+  for (size_t chunk = 0; chunk < numChunks; chunk++) {
+    tasks.push_back(pool->submit([&, chunk]() {
+      const source_IT first = begin + chunk * numTokens / numChunks;
+      const source_IT last = begin + (chunk + 1) * numTokens / numChunks;
+      partials[chunk] = minmax(first, last);
+    }));
+  }
+  waitAll(tasks);
+
+  std::pair<T, T> result = partials.front();
+  for (const auto& partial : partials) {
+    result.first = std::min(result.first, partial.first);
+    result.second = std::max(result.second, partial.second);
+  }
+  return result;
+}
+
+// Frequencies of the values min, min + 1, ..., min + size - 1 in tokens. All
+// tokens have to lie in this range.
+//
+// With a pool, large inputs are split into chunks that are counted into
+// private histograms on the workers, which then sum disjoint parts of them in
+// parallel.
+template <typename source_IT>
+std::vector<uint32_t> histogram(source_IT begin, source_IT end, int64_t min,
+                                size_t size, ThreadPool* pool = nullptr) {
+  const size_t numTokens = end - begin;
+  const size_t numChunks = histogramChunks(numTokens, size, pool);
+  if (numChunks == 1) {
+    std::vector<uint32_t> frequencies(size, 0);
+    countTokens(begin, end, min, frequencies.data(), size);
+    return frequencies;
+  }
+
+  std::vector<std::vector<uint32_t>> partials(numChunks);
+  std::vector<std::future<void>> tasks;
+  for (size_t chunk = 0; chunk < numChunks; chunk++) {
+    tasks.push_back(pool->submit([&, chunk]() {
+      const source_IT first = begin + chunk * numTokens / numChunks;
+      const source_IT last = begin + (chunk + 1) * numTokens / numChunks;
+      partials[chunk].resize(size, 0);
+      countTokens(first, last, min, partials[chunk].data(), size);
+    }));
+  }
+  waitAll(tasks);
+
+  tasks.clear();
+  for (size_t chunk = 0; chunk < numChunks; chunk++) {
+    tasks.push_back(pool->submit([&, chunk]() {
+      const size_t first = chunk * size / numChunks;
+      const size_t last = (chunk + 1) * size / numChunks;
+      for (size_t partial = 1; partial < numChunks; partial++) {
+        for (size_t i = first; i < last; i++) {
+          partials.front()[i] += partials[partial][i];
+        }
+      }
+    }));
+  }
+  waitAll(tasks);
+  return std::move(partials.front());
+}
+
+}  // namespace rans
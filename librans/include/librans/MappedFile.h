@@ -0,0 +1,57 @@
+/*
+ * MappedFile.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "Span.h"
+
+namespace rans {
+
+// A file mapped read only into memory, so its contents can be coded in place
+// without copying them into a (zero filled) buffer first.
+//
+// The kernel is told that the mapping is read front to back, which doubles
+// read ahead and drops pages behind the reader, and large mappings are
+// offered transparent huge pages where supported.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  const uint8_t* data() const;
+  size_t size() const;
+
+  // The contents as elements of T. Throws unless the size is a multiple of
+  // sizeof(T); mappings are page aligned.
+  template <typename T>
+  Span<const T> as() const;
+
+ private:
+  void unmap();
+
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <typename T>
+Span<const T> MappedFile::as() const {
+  if (size_ % sizeof(T)) {
+    throw std::runtime_error("file size is not a multiple of the data type");
+  }
+  return Span<const T>(reinterpret_cast<const T*>(data_), size_ / sizeof(T));
+}
+
+}  // namespace rans
@@ -0,0 +1,198 @@
+/*
+ * OutputBuffer.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "Coder.h"
+
+namespace rans {
+
+// Upper bound on the stream words written when coding numSymbols symbols
+// with N interleaved states in the layout of Encoder, flushes included. The
+// overflow checks of the encoders never fire for buffers of this size.
+template <typename coder_T, typename stream_T, size_t N>
+constexpr size_t maxCompressedSize(size_t numSymbols, size_t probabilityBits) {
+  using Rans = Coder<coder_T, stream_T>;
+  // the first numSymbols % N states code one symbol more than the others.
+  const size_t longLanes = numSymbols % N;
+  return longLanes * Rans::encMaxWords(numSymbols / N + 1, probabilityBits) +
+         (N - longLanes) * Rans::encMaxWords(numSymbols / N, probabilityBits);
+}
+
+// Storage the encoders write their streams into, backwards from end().
+//
+// Capacity grows in whole chunks and never shrinks, so a buffer reused for
+// similar inputs stops allocating after the first few. Unlike a std::vector,
+// storage is not zeroed on allocation.
+template <typename stream_T>
+class OutputBuffer {
+ public:
+  inline static constexpr size_t DEFAULT_CHUNK_SIZE = 1 << 16;  // words
+
+  explicit OutputBuffer(size_t capacity = 0,
+                        size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+  // Makes room for at least capacity words. Contents are not preserved when
+  // the buffer grows.
+  void reserve(size_t capacity);
+
+  stream_T* begin() { return data_.get(); }
+  stream_T* end() { return data_.get() + capacity_; }
+  const stream_T* begin() const { return data_.get(); }
+  const stream_T* end() const { return data_.get() + capacity_; }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  size_t chunkSize_;
+  size_t capacity_ = 0;
+  std::unique_ptr<stream_T[]> data_;
+};
+
+// Thread safe pool of OutputBuffers that are reused across jobs, so
+// concurrent jobs hold buffers sized for their own input instead of one
+// worst case allocation each.
+template <typename stream_T>
+class OutputArena {
+ public:
+  // A buffer taken from the arena, returned to it on destruction. Must not
+  // outlive the arena.
+  class Lease {
+   public:
+    Lease(Lease&& other) = default;
+    Lease& operator=(Lease&& other) = delete;
+    ~Lease() {
+      if (buffer_) {
+        arena_->release(std::move(buffer_));
+      }
+    }
+
+    OutputBuffer<stream_T>& operator*() const { return *buffer_; }
+    OutputBuffer<stream_T>* operator->() const { return buffer_.get(); }
+
+   private:
+    friend class OutputArena;
+    Lease(OutputArena* arena, std::unique_ptr<OutputBuffer<stream_T>> buffer)
+        : arena_(arena), buffer_(std::move(buffer)) {}
+
+    OutputArena* arena_;
+    std::unique_ptr<OutputBuffer<stream_T>> buffer_;
+  };
+
+  explicit OutputArena(
+      size_t chunkSize = OutputBuffer<stream_T>::DEFAULT_CHUNK_SIZE);
+
+  // A buffer of at least capacity words. Prefers the smallest idle buffer
+  // that is large enough, otherwise grows the largest idle one.
+  Lease acquire(size_t capacity);
+
+  // Idle buffers and the words they hold.
+  size_t getNumIdle() const;
+  size_t getIdleCapacity() const;
+
+  // Frees all idle buffers.
+  void clear();
+
+ private:
+  void release(std::unique_ptr<OutputBuffer<stream_T>> buffer);
+
+  size_t chunkSize_;
+  mutable std::mutex mutex_;
+  // ordered by capacity
+  std::vector<std::unique_ptr<OutputBuffer<stream_T>>> idle_;
+};
+
+template <typename stream_T>
+OutputBuffer<stream_T>::OutputBuffer(size_t capacity, size_t chunkSize)
+    : chunkSize_(chunkSize) {
+  if (chunkSize_ == 0) {
+    throw std::runtime_error("chunk size must not be 0");
+  }
+  reserve(capacity);
+}
+
+template <typename stream_T>
+void OutputBuffer<stream_T>::reserve(size_t capacity) {
+  if (capacity <= capacity_) {
+    return;
+  }
+  const size_t chunks = (capacity + chunkSize_ - 1) / chunkSize_;
+  data_.reset();  // don't hold old and new storage at once
+  data_.reset(new stream_T[chunks * chunkSize_]);
+  capacity_ = chunks * chunkSize_;
+}
+
+template <typename stream_T>
+OutputArena<stream_T>::OutputArena(size_t chunkSize) : chunkSize_(chunkSize) {}
+
+template <typename stream_T>
+typename OutputArena<stream_T>::Lease OutputArena<stream_T>::acquire(
+    size_t capacity) {
+  std::unique_ptr<OutputBuffer<stream_T>> buffer;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!idle_.empty()) {
+      auto fit = std::find_if(idle_.begin(), idle_.end(),
+                              [capacity](const auto& idle) {
+                                return idle->capacity() >= capacity;
+                              });
+      if (fit == idle_.end()) {
+        fit = std::prev(idle_.end());
+      }
+      buffer = std::move(*fit);
+      idle_.erase(fit);
+    }
+  }
+  if (buffer) {
+    buffer->reserve(capacity);
+  } else {
+    buffer = std::make_unique<OutputBuffer<stream_T>>(capacity, chunkSize_);
+  }
+  return Lease(this, std::move(buffer));
+}
+
+template <typename stream_T>
+void OutputArena<stream_T>::release(
+    std::unique_ptr<OutputBuffer<stream_T>> buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto position = std::find_if(idle_.begin(), idle_.end(),
+                               [&buffer](const auto& idle) {
+                                 return idle->capacity() >= buffer->capacity();
+                               });
+  idle_.insert(position, std::move(buffer));
+}
+
+template <typename stream_T>
+size_t OutputArena<stream_T>::getNumIdle() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_.size();
+}
+
+template <typename stream_T>
+size_t OutputArena<stream_T>::getIdleCapacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t capacity = 0;
+  for (const auto& idle : idle_) {
+    capacity += idle->capacity();
+  }
+  return capacity;
+}
+
+template <typename stream_T>
+void OutputArena<stream_T>::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  idle_.clear();
+}
+
+}  // namespace rans
@@ -0,0 +1,463 @@
+/*
+ * SIMDDecoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include "SIMDLevel.h"
+
+#ifdef RANS_X86
+#include <immintrin.h>
+#endif
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Decoder for 8 interleaved rANS states with a 32 bit state and 16 bit word
+// I/O, i.e. streams written by Coder<uint32_t, uint16_t>.
+//
+// Stream layout (this is what the encoder has to produce):
+//
+// 1. Symbol i is coded by state (lane) i % 8.
+// 2. The encoder works in reverse: last symbol first, and within a group of
+//    8 symbols lane 7 first. Words are written backwards, so the decoder reads
+//    them forwards in lane order 0..7.
+// 3. The encoder flushes lane 7 first, so the 8 states sit in lane order at
+//    the beginning of the stream and can be loaded with one 256 bit load.
+//
+// A trailing group of fewer than 8 symbols is coded by lanes 0..n%8-1 and
+// decoded with the scalar fallback after the vectorized loop.
+//
+// The kernel is picked at run time like the one of SIMDEncoder. AVX2 keeps the
+// 8 states in one register and gathers from the slot tables, AVX-512 replaces
+// the permutation table of the renormalization with an expand. SSE4.1 works
+// on two halves of 4 states with scalar table lookups.
+template <typename source_T>
+class SIMDDecoder {
+  static_assert(sizeof(source_T) == 1 || sizeof(source_T) == 2 ||
+                    sizeof(source_T) == 4,
+                "unsupported source type");
+
+ public:
+  using stream_t = uint16_t;
+  using state_t = uint32_t;
+
+  static constexpr size_t NLANES = 8;
+
+  // Uses the best kernel of the machine unless level says otherwise.
+  SIMDDecoder(const SymbolStatistics& stats, size_t probabilityBits,
+              SIMDLevel level = detectSIMDLevel());
+
+  // Decodes numSymbols symbols from the stream [begin,end) into output.
+  // Throws instead of reading past end when the stream is truncated.
+  void decode(const stream_t* begin, const stream_t* end, source_T* output,
+              size_t numSymbols) const;
+
+  SIMDLevel getLevel() const { return level_; }
+
+ private:
+  // The kernels decode numSymbols, a multiple of NLANES, from states.
+  void decodeScalar(const stream_t** pptr, const stream_t* end,
+                    source_T* output, size_t numSymbols,
+                    state_t* states) const;
+
+#ifdef RANS_X86
+  RANS_TARGET_AVX2 void decodeAVX2(const stream_t** pptr, const stream_t* end,
+                                   source_T* output, size_t numSymbols,
+                                   state_t* states) const;
+  RANS_TARGET_AVX512 void decodeAVX512(const stream_t** pptr,
+                                       const stream_t* end, source_T* output,
+                                       size_t numSymbols,
+                                       state_t* states) const;
+  RANS_TARGET_SSE41 void decodeSSE41(const stream_t** pptr,
+                                     const stream_t* end, source_T* output,
+                                     size_t numSymbols,
+                                     state_t* states) const;
+  RANS_TARGET_SSE41 void decodeHalf(__m128i* x, const stream_t** pptr,
+                                    const stream_t* end,
+                                    source_T* output) const;
+
+  RANS_TARGET_AVX2 static void storeSymbols(__m256i symbols, source_T* output);
+
+  // Maps a mask of lanes that need a new word to the index of the word each
+  // lane takes from the next 8 words in the stream: lane i gets the word at
+  // popcount(mask & ((1 << i) - 1)).
+  static constexpr std::array<uint64_t, 256> buildPermutations() {
+    std::array<uint64_t, 256> permutations{};
+    for (uint32_t mask = 0; mask < 256; mask++) {
+      uint64_t permutation = 0;
+      uint32_t word = 0;
+      for (uint32_t lane = 0; lane < NLANES; lane++) {
+        if (mask & (1u << lane)) {
+          permutation |= static_cast<uint64_t>(word++) << (lane * 8);
+        }
+      }
+      permutations[mask] = permutation;
+    }
+    return permutations;
+  }
+
+  // The same for 4 lanes as byte shuffles from words to 32 bit lanes.
+  static constexpr std::array<std::array<uint8_t, 16>, 16> buildExpansions() {
+    std::array<std::array<uint8_t, 16>, 16> expansions{};
+    for (uint32_t mask = 0; mask < 16; mask++) {
+      uint32_t word = 0;
+      for (uint32_t lane = 0; lane < 4; lane++) {
+        const bool takesWord = mask & (1u << lane);
+        expansions[mask][4 * lane] = takesWord ? 2 * word : 0x80;
+        expansions[mask][4 * lane + 1] = takesWord ? 2 * word + 1 : 0x80;
+        expansions[mask][4 * lane + 2] = 0x80;
+        expansions[mask][4 * lane + 3] = 0x80;
+        word += takesWord;
+      }
+    }
+    return expansions;
+  }
+
+  inline static constexpr std::array<uint64_t, 256> PERMUTATIONS_ =
+      buildPermutations();
+  inline static constexpr std::array<std::array<uint8_t, 16>, 16>
+      EXPANSIONS_ = buildExpansions();
+#endif
+
+  inline static constexpr state_t LOWER_BOUND_ = 1u << 15;
+
+  // The number of slots of the tables for stats, throws unless the
+  // frequencies sum up to 1 << probabilityBits, of at most 15 bits.
+  static size_t checkedNumSlots(const SymbolStatistics& stats,
+                                size_t probabilityBits);
+
+  SIMDLevel level_;
+  uint32_t probabilityBits_;
+  // per slot: freq in the low, slot - start in the high 16 bits.
+  std::vector<uint32_t> slotFreqBias_;
+  std::vector<int32_t> slotSymbol_;
+};
+
+template <typename source_T>
+SIMDDecoder<source_T>::SIMDDecoder(const SymbolStatistics& stats,
+                                   size_t probabilityBits, SIMDLevel level)
+    : level_(level),
+      probabilityBits_(probabilityBits),
+      slotFreqBias_(checkedNumSlots(stats, probabilityBits), 0),
+      slotSymbol_(slotFreqBias_.size(), 0) {
+  if (!isSupported(level)) {
+    throw std::runtime_error("SIMD level " + toString(level) +
+                             " is not supported by this machine");
+  }
+
+  int symbol = stats.minSymbol();
+  for (const auto& entry : stats) {
+    const uint32_t freq = entry.first;
+    const uint32_t start = entry.second;
+    for (uint32_t slot = start; slot < start + freq; slot++) {
+      slotFreqBias_[slot] = freq | ((slot - start) << 16);
+      slotSymbol_[slot] = symbol;
+    }
+    symbol++;
+  }
+}
+
+template <typename source_T>
+size_t SIMDDecoder<source_T>::checkedNumSlots(const SymbolStatistics& stats,
+                                              size_t probabilityBits) {
+  if (probabilityBits > 15) {
+    throw std::runtime_error(
+        "SIMD decoder supports at most 15 probability bits");
+  }
+  // the slots of every symbol are filled without further bounds checks.
+  uint64_t cumulatedFrequency = 0;
+  for (const auto& entry : stats) {
+    cumulatedFrequency += entry.first;
+  }
+  if (cumulatedFrequency != 1u << probabilityBits) {
+    throw std::runtime_error(
+        "frequencies do not sum up to 1 << probabilityBits");
+  }
+  return cumulatedFrequency;
+}
+
+template <typename source_T>
+void SIMDDecoder<source_T>::decode(const stream_t* begin, const stream_t* end,
+                                   source_T* output, size_t numSymbols) const {
+  const stream_t* ptr = begin;
+
+  // lane i's state is ptr[2i] | ptr[2i+1] << 16, i.e. a plain 256 bit load.
+  if (end - ptr < static_cast<ptrdiff_t>(2 * NLANES)) {
+    throw std::runtime_error("corrupt data: truncated stream");
+  }
+  alignas(32) state_t states[NLANES];
+  std::memcpy(states, ptr, sizeof(states));
+  ptr += 2 * NLANES;
+
+  const size_t numVectorSymbols = numSymbols & ~(NLANES - 1);
+  switch (level_) {
+#ifdef RANS_X86
+    case SIMDLevel::AVX512:
+      decodeAVX512(&ptr, end, output, numVectorSymbols, states);
+      break;
+    case SIMDLevel::AVX2:
+      decodeAVX2(&ptr, end, output, numVectorSymbols, states);
+      break;
+    case SIMDLevel::SSE41:
+      decodeSSE41(&ptr, end, output, numVectorSymbols, states);
+      break;
+#endif
+    default:
+      decodeScalar(&ptr, end, output, numVectorSymbols, states);
+  }
+
+  // scalar tail on the first numSymbols % 8 lanes.
+  const state_t mask = (1u << probabilityBits_) - 1;
+  for (size_t i = numVectorSymbols; i < numSymbols; i++) {
+    state_t& state = states[i - numVectorSymbols];
+    const state_t slot = state & mask;
+    output[i] = static_cast<source_T>(slotSymbol_[slot]);
+    state = (slotFreqBias_[slot] & 0xffff) * (state >> probabilityBits_) +
+            (slotFreqBias_[slot] >> 16);
+  }
+  for (size_t i = numVectorSymbols; i < numSymbols; i++) {
+    state_t& state = states[i - numVectorSymbols];
+    if (state < LOWER_BOUND_) {
+      if (ptr == end) {
+        throw std::runtime_error("corrupt data: truncated stream");
+      }
+      state = (state << 16) | *ptr++;
+    }
+  }
+}
+
+template <typename source_T>
+void SIMDDecoder<source_T>::decodeScalar(const stream_t** pptr,
+                                         const stream_t* end,
+                                         source_T* output, size_t numSymbols,
+                                         state_t* states) const {
+  const stream_t* ptr = *pptr;
+  const state_t mask = (1u << probabilityBits_) - 1;
+  for (size_t i = 0; i < numSymbols; i += NLANES) {
+    for (size_t lane = 0; lane < NLANES; lane++) {
+      state_t& state = states[lane];
+      const state_t slot = state & mask;
+      output[i + lane] = static_cast<source_T>(slotSymbol_[slot]);
+      state = (slotFreqBias_[slot] & 0xffff) * (state >> probabilityBits_) +
+              (slotFreqBias_[slot] >> 16);
+      if (state < LOWER_BOUND_) {
+        if (ptr == end) {
+          throw std::runtime_error("corrupt data: truncated stream");
+        }
+        state = (state << 16) | *ptr++;
+      }
+    }
+  }
+  *pptr = ptr;
+}
+
+#ifdef RANS_X86
+
+template <typename source_T>
+RANS_TARGET_AVX2 void SIMDDecoder<source_T>::decodeAVX2(
+    const stream_t** pptr, const stream_t* end, source_T* output,
+    size_t numSymbols, state_t* states) const {
+  const stream_t* ptr = *pptr;
+  __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(states));
+
+  const __m256i slotMask = _mm256_set1_epi32((1u << probabilityBits_) - 1);
+  const __m256i lowMask = _mm256_set1_epi32(0xffff);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m128i scaleBits = _mm_cvtsi32_si128(probabilityBits_);
+  const int* freqBias = reinterpret_cast<const int*>(slotFreqBias_.data());
+  const int* symbols = slotSymbol_.data();
+
+  for (size_t i = 0; i < numSymbols; i += NLANES) {
+    // s = cum2sym[x & mask]
+    const __m256i slots = _mm256_and_si256(x, slotMask);
+    const __m256i fb = _mm256_i32gather_epi32(freqBias, slots, 4);
+    storeSymbols(_mm256_i32gather_epi32(symbols, slots, 4), output + i);
+
+    // x = freq * (x >> scale_bits) + (x & mask) - start
+    const __m256i freq = _mm256_and_si256(fb, lowMask);
+    const __m256i bias = _mm256_srli_epi32(fb, 16);
+    x = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srl_epi32(x, scaleBits), freq),
+                         bias);
+
+    // renormalize: all lanes with x < L shift in one word, in lane order.
+    const __m256i renorm = _mm256_cmpeq_epi32(_mm256_srli_epi32(x, 15), zero);
+    const uint32_t renormMask =
+        _mm256_movemask_ps(_mm256_castsi256_ps(renorm));
+
+    __m128i nextWords;
+    if (end - ptr >= static_cast<ptrdiff_t>(NLANES)) {
+      nextWords = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    } else {
+      // don't read past the end of the stream.
+      if (end - ptr < __builtin_popcount(renormMask)) {
+        throw std::runtime_error("corrupt data: truncated stream");
+      }
+      alignas(16) stream_t tail[NLANES] = {};
+      std::memcpy(tail, ptr, (end - ptr) * sizeof(stream_t));
+      nextWords = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+    }
+    const __m256i permutation = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(
+        static_cast<long long>(PERMUTATIONS_[renormMask])));
+    const __m256i words = _mm256_permutevar8x32_epi32(
+        _mm256_cvtepu16_epi32(nextWords), permutation);
+    x = _mm256_blendv_epi8(x, _mm256_or_si256(_mm256_slli_epi32(x, 16), words),
+                           renorm);
+    ptr += __builtin_popcount(renormMask);
+  }
+
+  _mm256_store_si256(reinterpret_cast<__m256i*>(states), x);
+  *pptr = ptr;
+}
+
+template <typename source_T>
+RANS_TARGET_AVX512 void SIMDDecoder<source_T>::decodeAVX512(
+    const stream_t** pptr, const stream_t* end, source_T* output,
+    size_t numSymbols, state_t* states) const {
+  const stream_t* ptr = *pptr;
+  __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(states));
+
+  const __m256i slotMask = _mm256_set1_epi32((1u << probabilityBits_) - 1);
+  const __m256i lowMask = _mm256_set1_epi32(0xffff);
+  const __m256i lowerBound = _mm256_set1_epi32(LOWER_BOUND_);
+  const __m128i scaleBits = _mm_cvtsi32_si128(probabilityBits_);
+  const int* freqBias = reinterpret_cast<const int*>(slotFreqBias_.data());
+  const int* symbols = slotSymbol_.data();
+
+  for (size_t i = 0; i < numSymbols; i += NLANES) {
+    const __m256i slots = _mm256_and_si256(x, slotMask);
+    const __m256i fb = _mm256_i32gather_epi32(freqBias, slots, 4);
+    storeSymbols(_mm256_i32gather_epi32(symbols, slots, 4), output + i);
+
+    const __m256i freq = _mm256_and_si256(fb, lowMask);
+    const __m256i bias = _mm256_srli_epi32(fb, 16);
+    x = _mm256_add_epi32(
+        _mm256_mullo_epi32(_mm256_srl_epi32(x, scaleBits), freq), bias);
+
+    // renormalize: a masked load of exactly the words needed, expanded to
+    // the lanes that take them.
+    const __mmask8 renorm = _mm256_cmplt_epu32_mask(x, lowerBound);
+    const uint32_t count = __builtin_popcount(renorm);
+    if (end - ptr < static_cast<ptrdiff_t>(count)) {
+      throw std::runtime_error("corrupt data: truncated stream");
+    }
+    const __m128i nextWords =
+        _mm_maskz_loadu_epi16(static_cast<__mmask8>((1u << count) - 1), ptr);
+    const __m256i words =
+        _mm256_maskz_expand_epi32(renorm, _mm256_cvtepu16_epi32(nextWords));
+    x = _mm256_mask_or_epi32(x, renorm, _mm256_slli_epi32(x, 16), words);
+    ptr += count;
+  }
+
+  _mm256_store_si256(reinterpret_cast<__m256i*>(states), x);
+  *pptr = ptr;
+}
+
+template <typename source_T>
+RANS_TARGET_SSE41 void SIMDDecoder<source_T>::decodeSSE41(
+    const stream_t** pptr, const stream_t* end, source_T* output,
+    size_t numSymbols, state_t* states) const {
+  __m128i x[2] = {
+      _mm_load_si128(reinterpret_cast<const __m128i*>(states)),
+      _mm_load_si128(reinterpret_cast<const __m128i*>(states + 4))};
+  for (size_t i = 0; i < numSymbols; i += NLANES) {
+    // the words are read in lane order, lanes 0..3 first.
+    decodeHalf(&x[0], pptr, end, output + i);
+    decodeHalf(&x[1], pptr, end, output + i + 4);
+  }
+  _mm_store_si128(reinterpret_cast<__m128i*>(states), x[0]);
+  _mm_store_si128(reinterpret_cast<__m128i*>(states + 4), x[1]);
+}
+
+template <typename source_T>
+RANS_TARGET_SSE41 inline void SIMDDecoder<source_T>::decodeHalf(
+    __m128i* px, const stream_t** pptr, const stream_t* end,
+    source_T* output) const {
+  const stream_t* ptr = *pptr;
+  __m128i x = *px;
+
+  alignas(16) uint32_t slots[4];
+  const __m128i slotMask = _mm_set1_epi32((1u << probabilityBits_) - 1);
+  _mm_store_si128(reinterpret_cast<__m128i*>(slots),
+                  _mm_and_si128(x, slotMask));
+  const __m128i fb =
+      _mm_setr_epi32(slotFreqBias_[slots[0]], slotFreqBias_[slots[1]],
+                     slotFreqBias_[slots[2]], slotFreqBias_[slots[3]]);
+  for (size_t lane = 0; lane < 4; lane++) {
+    output[lane] = static_cast<source_T>(slotSymbol_[slots[lane]]);
+  }
+
+  const __m128i freq = _mm_and_si128(fb, _mm_set1_epi32(0xffff));
+  const __m128i bias = _mm_srli_epi32(fb, 16);
+  x = _mm_add_epi32(
+      _mm_mullo_epi32(
+          _mm_srl_epi32(x, _mm_cvtsi32_si128(probabilityBits_)), freq),
+      bias);
+
+  // renormalize, see the AVX2 version.
+  const __m128i renorm =
+      _mm_cmpeq_epi32(_mm_srli_epi32(x, 15), _mm_setzero_si128());
+  const uint32_t renormMask = _mm_movemask_ps(_mm_castsi128_ps(renorm));
+
+  __m128i nextWords;
+  if (end - ptr >= 4) {
+    nextWords = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr));
+  } else {
+    // don't read past the end of the stream.
+    if (end - ptr < __builtin_popcount(renormMask)) {
+      throw std::runtime_error("corrupt data: truncated stream");
+    }
+    alignas(16) stream_t tail[8] = {};
+    std::memcpy(tail, ptr, (end - ptr) * sizeof(stream_t));
+    nextWords = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+  }
+  const __m128i words = _mm_shuffle_epi8(
+      nextWords, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                     EXPANSIONS_[renormMask].data())));
+  *px = _mm_blendv_epi8(x, _mm_or_si128(_mm_slli_epi32(x, 16), words), renorm);
+  *pptr = ptr + __builtin_popcount(renormMask);
+}
+
+template <typename source_T>
+RANS_TARGET_AVX2 inline void SIMDDecoder<source_T>::storeSymbols(
+    __m256i symbols, source_T* output) {
+  // narrowed by truncation like the scalar kernels' cast: saturating packs
+  // would clamp negative symbols of a signed source_T.
+  if constexpr (sizeof(source_T) == 4) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), symbols);
+  } else if constexpr (sizeof(source_T) == 2) {
+    // 16 bit: the low words into dword 0 and 1 of both 128 bit lanes, then
+    // gather qwords 0 and 2.
+    const __m256i words = _mm256_shuffle_epi8(
+        symbols, _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1,
+                                  -1, -1, -1, 0, 1, 4, 5, 8, 9, 12, 13, -1, -1,
+                                  -1, -1, -1, -1, -1, -1));
+    const __m256i packed = _mm256_permute4x64_epi64(words, 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     _mm256_castsi256_si128(packed));
+  } else {
+    // 8 bit: the low bytes into dword 0 of both 128 bit lanes, then gather
+    // dwords 0 and 4.
+    const __m256i bytes = _mm256_shuffle_epi8(
+        symbols, _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1,
+                                  -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1,
+                                  -1, -1, -1, -1, -1, -1, -1, -1));
+    const __m256i packed = _mm256_permutevar8x32_epi32(
+        bytes, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output),
+                     _mm256_castsi256_si128(packed));
+  }
+}
+
+#endif /* RANS_X86 */
+
+}  // namespace rans
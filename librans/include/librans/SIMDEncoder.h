@@ -0,0 +1,455 @@
+/*
+ * SIMDEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include "SIMDLevel.h"
+
+#ifdef RANS_X86
+#include <immintrin.h>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Coder.h"
+#include "EncoderSymbol.h"
+#include "SymbolStatistics.h"
+#include "SymbolTable.h"
+
+namespace rans {
+
+// Vectorized encoder for 8 interleaved rANS states with a 32 bit state and 16
+// bit word I/O. It produces exactly the stream layout described in
+// SIMDDecoder.h, i.e. the same bytes as running Coder<uint32_t, uint16_t> on 8
+// interleaved states, and uses the reciprocal EncoderSymbol path: the
+// EncoderSymbol fields are gathered per lane and the division is done as
+// mul_hi(x, rcp_freq) >> rcp_shift.
+//
+// The kernel is picked at run time, all of them produce the same stream. With
+// AVX2 all 8 states live in one register, AVX-512 additionally compresses the
+// emitted words with a masked store instead of a permutation table. The SSE4.1
+// kernel works on two halves of 4 states, loads the symbols without gathers
+// and emulates the per lane shift. The scalar kernel runs Coder on the lanes.
+template <typename source_T>
+class SIMDEncoder {
+  static_assert(sizeof(source_T) == 1 || sizeof(source_T) == 2 ||
+                    sizeof(source_T) == 4,
+                "unsupported source type");
+  static_assert(sizeof(EncoderSymbol<uint32_t>) == 6 * sizeof(uint32_t),
+                "EncoderSymbol layout does not allow gathers");
+
+ public:
+  using stream_t = uint16_t;
+  using state_t = uint32_t;
+
+  static constexpr size_t NLANES = 8;
+
+  // Uses the best kernel of the machine unless level says otherwise.
+  SIMDEncoder(const SymbolStatistics& stats, size_t probabilityBits,
+              SIMDLevel level = detectSIMDLevel());
+
+  // Encodes the symbols [begin,end) into the buffer [outBegin,outEnd). The
+  // stream is written backwards from outEnd, the return value is its start.
+  stream_t* encode(const source_T* begin, const source_T* end,
+                   stream_t* outBegin, stream_t* outEnd) const;
+
+  SIMDLevel getLevel() const { return level_; }
+
+ private:
+  using Rans = Coder<state_t, stream_t>;
+
+  // The kernels encode numSymbols, a multiple of NLANES, starting at begin
+  // into states.
+  void encodeScalar(const source_T* begin, size_t numSymbols, state_t* states,
+                    stream_t** pptr, const stream_t* outBegin) const;
+
+  // Maps a mask of lanes that emit a word to a permutation moving the low
+  // words of those lanes, in lane order, to the top of a group of nLanes.
+  template <size_t nLanes>
+  static constexpr std::array<uint64_t, 1 << nLanes> buildCompactions() {
+    std::array<uint64_t, 1 << nLanes> compactions{};
+    for (uint32_t mask = 0; mask < (1u << nLanes); mask++) {
+      uint32_t count = 0;
+      for (uint32_t lane = 0; lane < nLanes; lane++) {
+        count += (mask >> lane) & 1;
+      }
+      uint64_t compaction = 0;
+      uint32_t position = nLanes - count;
+      for (uint32_t lane = 0; lane < nLanes; lane++) {
+        if (mask & (1u << lane)) {
+          compaction |= static_cast<uint64_t>(lane) << (8 * position++);
+        }
+      }
+      compactions[mask] = compaction;
+    }
+    return compactions;
+  }
+
+  static void writeWords(const void* words, size_t nLanes, size_t count,
+                         stream_t** pptr, const stream_t* outBegin);
+
+#ifdef RANS_X86
+  // the EncoderSymbol fields of 8 symbols.
+  struct SymbolVectors {
+    __m256i rcpFreq;
+    __m256i freq;
+    __m256i bias;
+    __m256i cmplFreq;
+    __m256i rcpShift;
+  };
+
+  RANS_TARGET_AVX2 SymbolVectors gatherSymbols(const source_T* symbols) const;
+  // x = C(s,x) on renormalized states.
+  RANS_TARGET_AVX2 static __m256i putSymbols(__m256i x,
+                                             const SymbolVectors& symbols);
+
+  RANS_TARGET_AVX2 void encodeAVX2(const source_T* begin, size_t numSymbols,
+                                   state_t* states, stream_t** pptr,
+                                   const stream_t* outBegin) const;
+  RANS_TARGET_AVX512 void encodeAVX512(const source_T* begin,
+                                       size_t numSymbols, state_t* states,
+                                       stream_t** pptr,
+                                       const stream_t* outBegin) const;
+  RANS_TARGET_SSE41 void encodeSSE41(const source_T* begin, size_t numSymbols,
+                                     state_t* states, stream_t** pptr,
+                                     const stream_t* outBegin) const;
+  RANS_TARGET_SSE41 void encodeHalf(__m128i* x, const source_T* symbols,
+                                    stream_t** pptr,
+                                    const stream_t* outBegin) const;
+
+  inline static constexpr std::array<uint64_t, 256> COMPACTIONS_ =
+      buildCompactions<8>();
+
+  // byte shuffles for the compactions: the word of lane l is bytes 4l, 4l+1.
+  static constexpr std::array<std::array<uint8_t, 16>, 16> buildShuffles() {
+    constexpr std::array<uint64_t, 16> compactions = buildCompactions<4>();
+    std::array<std::array<uint8_t, 16>, 16> shuffles{};
+    for (uint32_t mask = 0; mask < 16; mask++) {
+      uint32_t count = 0;
+      for (uint32_t lane = 0; lane < 4; lane++) {
+        count += (mask >> lane) & 1;
+      }
+      for (uint32_t position = 0; position < 16; position++) {
+        shuffles[mask][position] = 0x80;
+      }
+      for (uint32_t position = 4 - count; position < 4; position++) {
+        const uint8_t lane = compactions[mask] >> (8 * position);
+        shuffles[mask][2 * position] = 4 * lane;
+        shuffles[mask][2 * position + 1] = 4 * lane + 1;
+      }
+    }
+    return shuffles;
+  }
+
+  inline static constexpr std::array<std::array<uint8_t, 16>, 16> SHUFFLES_ =
+      buildShuffles();
+#endif
+
+  SIMDLevel level_;
+  uint32_t probabilityBits_;
+  int minSymbol_;
+  SymbolTable<EncoderSymbol<state_t>> symbolTable_;
+};
+
+template <typename source_T>
+SIMDEncoder<source_T>::SIMDEncoder(const SymbolStatistics& stats,
+                                   size_t probabilityBits, SIMDLevel level)
+    : level_(level),
+      probabilityBits_(probabilityBits),
+      minSymbol_(stats.minSymbol()),
+      symbolTable_(stats, probabilityBits) {
+  if (probabilityBits > 15) {
+    throw std::runtime_error(
+        "SIMD encoder supports at most 15 probability bits");
+  }
+  if (!isSupported(level)) {
+    throw std::runtime_error("SIMD level " + toString(level) +
+                             " is not supported by this machine");
+  }
+}
+
+template <typename source_T>
+typename SIMDEncoder<source_T>::stream_t* SIMDEncoder<source_T>::encode(
+    const source_T* begin, const source_T* end, stream_t* outBegin,
+    stream_t* outEnd) const {
+  const size_t numSymbols = end - begin;
+  const size_t tail = numSymbols % NLANES;
+  stream_t* ptr = outEnd;
+
+  alignas(32) state_t states[NLANES];
+  for (auto& state : states) {
+    Rans::encInit(&state);
+  }
+
+  // incomplete last group is coded by the first lanes
+  for (size_t lane = tail; lane > 0; lane--) {
+    if (ptr - outBegin < 1) {
+      throw std::runtime_error("output buffer too small");
+    }
+    Rans::encPutSymbol(&states[lane - 1], &ptr,
+                       &symbolTable_[begin[numSymbols - tail + lane - 1]],
+                       probabilityBits_);
+  }
+
+  switch (level_) {
+#ifdef RANS_X86
+    case SIMDLevel::AVX512:
+      encodeAVX512(begin, numSymbols - tail, states, &ptr, outBegin);
+      break;
+    case SIMDLevel::AVX2:
+      encodeAVX2(begin, numSymbols - tail, states, &ptr, outBegin);
+      break;
+    case SIMDLevel::SSE41:
+      encodeSSE41(begin, numSymbols - tail, states, &ptr, outBegin);
+      break;
+#endif
+    default:
+      encodeScalar(begin, numSymbols - tail, states, &ptr, outBegin);
+  }
+
+  // flush lane 7 first; lane i's state ends up at ptr[2i], ptr[2i+1].
+  if (ptr - outBegin < static_cast<ptrdiff_t>(2 * NLANES)) {
+    throw std::runtime_error("output buffer too small");
+  }
+  for (size_t lane = NLANES; lane > 0; lane--) {
+    Rans::encFlush(&states[lane - 1], &ptr);
+  }
+  return ptr;
+}
+
+template <typename source_T>
+void SIMDEncoder<source_T>::encodeScalar(const source_T* begin,
+                                         size_t numSymbols, state_t* states,
+                                         stream_t** pptr,
+                                         const stream_t* outBegin) const {
+  for (size_t i = numSymbols; i > 0; i -= NLANES) {  // NB: working in reverse!
+    // every lane emits at most one word.
+    if (*pptr - outBegin < static_cast<ptrdiff_t>(NLANES)) {
+      throw std::runtime_error("output buffer too small");
+    }
+    for (size_t lane = NLANES; lane > 0; lane--) {
+      Rans::encPutSymbol(&states[lane - 1], pptr,
+                         &symbolTable_[begin[i - NLANES + lane - 1]],
+                         probabilityBits_);
+    }
+  }
+}
+
+template <typename source_T>
+inline void SIMDEncoder<source_T>::writeWords(const void* words, size_t nLanes,
+                                              size_t count, stream_t** pptr,
+                                              const stream_t* outBegin) {
+  // words holds nLanes words, the count emitted ones at the top.
+  stream_t* ptr = *pptr;
+  if (ptr - outBegin >= static_cast<ptrdiff_t>(nLanes)) {
+    std::memcpy(ptr - nLanes, words, nLanes * sizeof(stream_t));
+  } else if (ptr - outBegin >= static_cast<ptrdiff_t>(count)) {
+    // don't write in front of the output buffer.
+    std::memcpy(ptr - count,
+                static_cast<const stream_t*>(words) + nLanes - count,
+                count * sizeof(stream_t));
+  } else {
+    throw std::runtime_error("output buffer too small");
+  }
+  *pptr = ptr - count;
+}
+
+#ifdef RANS_X86
+
+template <typename source_T>
+RANS_TARGET_AVX2 inline typename SIMDEncoder<source_T>::SymbolVectors
+SIMDEncoder<source_T>::gatherSymbols(const source_T* symbols) const {
+  // widened with the sign of source_T, as the scalar kernels do.
+  __m256i s;
+  if constexpr (sizeof(source_T) == 4) {
+    s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(symbols));
+  } else if constexpr (sizeof(source_T) == 2) {
+    const __m128i loaded =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(symbols));
+    s = std::is_signed_v<source_T> ? _mm256_cvtepi16_epi32(loaded)
+                                   : _mm256_cvtepu16_epi32(loaded);
+  } else {
+    const __m128i loaded =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(symbols));
+    s = std::is_signed_v<source_T> ? _mm256_cvtepi8_epi32(loaded)
+                                   : _mm256_cvtepu8_epi32(loaded);
+  }
+  // index into the EncoderSymbol table in units of uint32_t.
+  s = _mm256_sub_epi32(s, _mm256_set1_epi32(minSymbol_));
+  s = _mm256_add_epi32(_mm256_slli_epi32(s, 2), _mm256_slli_epi32(s, 1));
+
+  const int* table =
+      reinterpret_cast<const int*>(&symbolTable_[minSymbol_]);
+  constexpr int STRIDE = sizeof(uint32_t);
+  SymbolVectors vectors;
+  vectors.rcpFreq = _mm256_i32gather_epi32(
+      table + offsetof(EncoderSymbol<state_t>, rcp_freq) / STRIDE, s, STRIDE);
+  vectors.freq = _mm256_i32gather_epi32(
+      table + offsetof(EncoderSymbol<state_t>, freq) / STRIDE, s, STRIDE);
+  vectors.bias = _mm256_i32gather_epi32(
+      table + offsetof(EncoderSymbol<state_t>, bias) / STRIDE, s, STRIDE);
+  vectors.cmplFreq = _mm256_i32gather_epi32(
+      table + offsetof(EncoderSymbol<state_t>, cmpl_freq) / STRIDE, s, STRIDE);
+  vectors.rcpShift = _mm256_i32gather_epi32(
+      table + offsetof(EncoderSymbol<state_t>, rcp_shift) / STRIDE, s, STRIDE);
+  return vectors;
+}
+
+template <typename source_T>
+RANS_TARGET_AVX2 inline __m256i SIMDEncoder<source_T>::putSymbols(
+    __m256i x, const SymbolVectors& symbols) {
+  // q = mul_hi(x, rcp_freq) >> rcp_shift
+  const __m256i productEven = _mm256_mul_epu32(x, symbols.rcpFreq);
+  const __m256i productOdd = _mm256_mul_epu32(
+      _mm256_srli_epi64(x, 32), _mm256_srli_epi64(symbols.rcpFreq, 32));
+  const __m256i q = _mm256_srlv_epi32(
+      _mm256_blend_epi32(_mm256_srli_epi64(productEven, 32), productOdd, 0xaa),
+      symbols.rcpShift);
+
+  return _mm256_add_epi32(_mm256_add_epi32(x, symbols.bias),
+                          _mm256_mullo_epi32(q, symbols.cmplFreq));
+}
+
+template <typename source_T>
+RANS_TARGET_AVX2 void SIMDEncoder<source_T>::encodeAVX2(
+    const source_T* begin, size_t numSymbols, state_t* states,
+    stream_t** pptr, const stream_t* outBegin) const {
+  const __m128i renormShift = _mm_cvtsi32_si128(31 - probabilityBits_);
+  __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(states));
+  for (size_t i = numSymbols; i > 0; i -= NLANES) {  // NB: working in reverse!
+    const SymbolVectors symbols = gatherSymbols(begin + i - NLANES);
+
+    // renormalize: x >= x_max = freq << (31 - scale_bits) emits its low word.
+    // x_max is a multiple of 1 << (31 - scale_bits), so compare x >> (31 -
+    // scale_bits) against freq instead of shifting freq per lane.
+    const __m256i keep =
+        _mm256_cmpgt_epi32(symbols.freq, _mm256_srl_epi32(x, renormShift));
+    const uint32_t emitMask =
+        ~_mm256_movemask_ps(_mm256_castsi256_ps(keep)) & 0xff;
+
+    const __m256i compaction = _mm256_cvtepu8_epi32(
+        _mm_cvtsi64_si128(static_cast<long long>(COMPACTIONS_[emitMask])));
+    const __m256i words = _mm256_permutevar8x32_epi32(
+        _mm256_and_si256(x, _mm256_set1_epi32(0xffff)), compaction);
+    alignas(16) stream_t packed[NLANES];
+    _mm_store_si128(reinterpret_cast<__m128i*>(packed),
+                    _mm256_castsi256_si128(_mm256_permute4x64_epi64(
+                        _mm256_packus_epi32(words, words), 0x08)));
+    writeWords(packed, NLANES, __builtin_popcount(emitMask), pptr, outBegin);
+
+    x = putSymbols(_mm256_blendv_epi8(_mm256_srli_epi32(x, 16), x, keep),
+                   symbols);
+  }
+  _mm256_store_si256(reinterpret_cast<__m256i*>(states), x);
+}
+
+template <typename source_T>
+RANS_TARGET_AVX512 void SIMDEncoder<source_T>::encodeAVX512(
+    const source_T* begin, size_t numSymbols, state_t* states,
+    stream_t** pptr, const stream_t* outBegin) const {
+  const __m128i renormShift = _mm_cvtsi32_si128(31 - probabilityBits_);
+  __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(states));
+  for (size_t i = numSymbols; i > 0; i -= NLANES) {  // NB: working in reverse!
+    const SymbolVectors symbols = gatherSymbols(begin + i - NLANES);
+
+    // renormalize, see the AVX2 version. The emitted words are compressed
+    // into the low lanes in lane order and stored with a mask, which touches
+    // no memory in front of the output buffer.
+    const __mmask8 emit = _mm256_cmple_epi32_mask(
+        symbols.freq, _mm256_srl_epi32(x, renormShift));
+    const uint32_t count = __builtin_popcount(emit);
+    if (*pptr - outBegin < static_cast<ptrdiff_t>(count)) {
+      throw std::runtime_error("output buffer too small");
+    }
+    *pptr -= count;
+    _mm_mask_storeu_epi16(
+        *pptr, static_cast<__mmask8>((1u << count) - 1),
+        _mm256_cvtepi32_epi16(_mm256_maskz_compress_epi32(emit, x)));
+
+    x = putSymbols(_mm256_mask_srli_epi32(x, emit, x, 16), symbols);
+  }
+  _mm256_store_si256(reinterpret_cast<__m256i*>(states), x);
+}
+
+template <typename source_T>
+RANS_TARGET_SSE41 void SIMDEncoder<source_T>::encodeSSE41(
+    const source_T* begin, size_t numSymbols, state_t* states,
+    stream_t** pptr, const stream_t* outBegin) const {
+  __m128i x[2] = {
+      _mm_load_si128(reinterpret_cast<const __m128i*>(states)),
+      _mm_load_si128(reinterpret_cast<const __m128i*>(states + 4))};
+  for (size_t i = numSymbols; i > 0; i -= NLANES) {  // NB: working in reverse!
+    encodeHalf(&x[1], begin + i - 4, pptr, outBegin);
+    encodeHalf(&x[0], begin + i - 8, pptr, outBegin);
+  }
+  _mm_store_si128(reinterpret_cast<__m128i*>(states), x[0]);
+  _mm_store_si128(reinterpret_cast<__m128i*>(states + 4), x[1]);
+}
+
+template <typename source_T>
+RANS_TARGET_SSE41 inline void SIMDEncoder<source_T>::encodeHalf(__m128i* px,
+                                              const source_T* symbols,
+                                              stream_t** pptr,
+                                              const stream_t* outBegin) const {
+  const EncoderSymbol<state_t>* sym[4] = {
+      &symbolTable_[symbols[0]], &symbolTable_[symbols[1]],
+      &symbolTable_[symbols[2]], &symbolTable_[symbols[3]]};
+  const __m128i rcpFreq =
+      _mm_setr_epi32(sym[0]->rcp_freq, sym[1]->rcp_freq, sym[2]->rcp_freq,
+                     sym[3]->rcp_freq);
+  const __m128i freq =
+      _mm_setr_epi32(sym[0]->freq, sym[1]->freq, sym[2]->freq, sym[3]->freq);
+  const __m128i bias =
+      _mm_setr_epi32(sym[0]->bias, sym[1]->bias, sym[2]->bias, sym[3]->bias);
+  const __m128i cmplFreq =
+      _mm_setr_epi32(sym[0]->cmpl_freq, sym[1]->cmpl_freq, sym[2]->cmpl_freq,
+                     sym[3]->cmpl_freq);
+  const __m128i rcpShift =
+      _mm_setr_epi32(sym[0]->rcp_shift, sym[1]->rcp_shift, sym[2]->rcp_shift,
+                     sym[3]->rcp_shift);
+
+  __m128i x = *px;
+
+  // renormalize, see the AVX2 version.
+  const __m128i xScaled =
+      _mm_srl_epi32(x, _mm_cvtsi32_si128(31 - probabilityBits_));
+  const __m128i keep = _mm_cmpgt_epi32(freq, xScaled);
+  const uint32_t emitMask = ~_mm_movemask_ps(_mm_castsi128_ps(keep)) & 0xf;
+
+  alignas(16) stream_t packed[8];
+  _mm_store_si128(
+      reinterpret_cast<__m128i*>(packed),
+      _mm_shuffle_epi8(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                              SHUFFLES_[emitMask].data()))));
+  const uint32_t count = __builtin_popcount(emitMask);
+  writeWords(packed, 4, count, pptr, outBegin);
+
+  x = _mm_blendv_epi8(_mm_srli_epi32(x, 16), x, keep);
+
+  // x = C(s,x): q = mul_hi(x, rcp_freq) >> rcp_shift
+  const __m128i productEven = _mm_mul_epu32(x, rcpFreq);
+  const __m128i productOdd =
+      _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(rcpFreq, 32));
+  __m128i q =
+      _mm_blend_epi16(_mm_srli_epi64(productEven, 32), productOdd, 0xcc);
+  // no per lane shifts before AVX2: shift by each bit of rcp_shift.
+  for (int bit = 1; bit < 32; bit <<= 1) {
+    const __m128i shiftBit = _mm_cmpeq_epi32(
+        _mm_and_si128(rcpShift, _mm_set1_epi32(bit)), _mm_set1_epi32(bit));
+    q = _mm_blendv_epi8(q, _mm_srl_epi32(q, _mm_cvtsi32_si128(bit)), shiftBit);
+  }
+
+  *px = _mm_add_epi32(_mm_add_epi32(x, bias), _mm_mullo_epi32(q, cmplFreq));
+}
+
+#endif /* RANS_X86 */
+
+}  // namespace rans
@@ -0,0 +1,47 @@
+/*
+ * SIMDLevel.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// The SIMD kernels are compiled for their instruction set with function target
+// attributes, so one binary built for the baseline ISA carries all of them and
+// picks one at run time. Nothing outside of these functions is compiled for a
+// newer ISA, so no shared inline or template code can leak instructions the
+// machine does not have.
+#if defined(__x86_64__) || defined(__i386__)
+#define RANS_X86 1
+#define RANS_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define RANS_TARGET_AVX2 __attribute__((target("avx2")))
+#define RANS_TARGET_AVX512 \
+  __attribute__((target("avx2,avx512f,avx512vl,avx512bw")))
+#endif
+
+namespace rans {
+
+// Instruction set of the SIMD coder kernels, in increasing order.
+enum class SIMDLevel {
+  Scalar,
+  SSE41,
+  AVX2,
+  AVX512,  // AVX-512 F, VL and BW on 256 bit vectors.
+};
+
+// The best level the CPU and the OS support. cpuid is queried on the first
+// call only.
+SIMDLevel detectSIMDLevel();
+
+bool isSupported(SIMDLevel level);
+
+// All levels the machine supports, Scalar first.
+std::vector<SIMDLevel> supportedSIMDLevels();
+
+std::string toString(SIMDLevel level);
+SIMDLevel simdLevelFromString(const std::string& name);
+
+}  // namespace rans
@@ -0,0 +1,79 @@
+/*
+ * Span.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace rans {
+
+template <typename T>
+class Span;
+
+template <typename T>
+struct isSpan : std::false_type {};
+
+template <typename T>
+struct isSpan<Span<T>> : std::true_type {};
+
+// Non owning view of a contiguous range of T, a minimal std::span for C++17.
+// Lets the statistics and codecs read tokens in place, e.g. straight from a
+// MappedFile, instead of requiring a std::vector copy.
+template <typename T>
+class Span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using iterator = T*;
+
+  constexpr Span() = default;
+  constexpr Span(T* data, size_t size) : data_(data), size_(size) {}
+  constexpr Span(T* begin, T* end) : data_(begin), size_(end - begin) {}
+
+  // Span<const T> from Span<T>.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr Span(const Span<U>& other)
+      : data_(other.data()), size_(other.size()) {}
+
+  // From any contiguous container with data() and size(), e.g. std::vector.
+  // Only binds to lvalues, so the span can not outlive a temporary.
+  template <typename Container,
+            typename = std::enable_if_t<
+                !isSpan<std::remove_cv_t<Container>>::value &&
+                std::is_convertible_v<
+                    std::remove_pointer_t<decltype(
+                        std::declval<Container&>().data())> (*)[],
+                    T (*)[]>>>
+  constexpr Span(Container& container)
+      : data_(container.data()), size_(container.size()) {}
+
+  constexpr T* data() const { return data_; }
+  constexpr size_t size() const { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
+
+  constexpr T* begin() const { return data_; }
+  constexpr T* end() const { return data_ + size_; }
+
+  constexpr T& operator[](size_t index) const { return data_[index]; }
+
+  // The count elements starting at offset.
+  Span subspan(size_t offset, size_t count) const {
+    if (offset > size_ || count > size_ - offset) {
+      throw std::out_of_range("subspan out of range");
+    }
+    return Span(data_ + offset, count);
+  }
+
+ private:
+  T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace rans
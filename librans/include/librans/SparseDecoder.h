@@ -0,0 +1,73 @@
+/*
+ * SparseDecoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Decoder.h"
+#include "EncodedSparse.h"
+#include "SparseSymbolStatistics.h"
+
+namespace rans {
+
+// Decodes the output of SparseEncoder<coder_T, stream_T, N>.
+template <typename coder_T, typename stream_T, size_t N>
+class SparseDecoder {
+ public:
+  // stats has to outlive the decoder.
+  SparseDecoder(const SparseSymbolStatistics& stats, size_t probabilityBits);
+
+  // output has to hold encoded.numSymbols symbols and be of the type the
+  // values were encoded from.
+  template <typename source_T>
+  void decode(const EncodedSparse<stream_T>& encoded, source_T* output) const;
+
+ private:
+  const SparseSymbolStatistics& stats_;
+  Decoder<coder_T, stream_T, N> decoder_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+SparseDecoder<coder_T, stream_T, N>::SparseDecoder(
+    const SparseSymbolStatistics& stats, size_t probabilityBits)
+    : stats_(stats), decoder_(stats.getIndexStatistics(), probabilityBits) {}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_T>
+void SparseDecoder<coder_T, stream_T, N>::decode(
+    const EncodedSparse<stream_T>& encoded, source_T* output) const {
+  const uint32_t escapeIndex = stats_.getEscapeIndex();
+  constexpr size_t RAW_BITS = 8 * sizeof(source_T);
+  std::vector<uint32_t> indices(encoded.numSymbols);
+  decoder_.decode(encoded.stream.data(), indices.begin(), indices.size());
+
+  size_t bitPos = 0;
+  for (size_t i = 0; i < indices.size(); i++) {
+    if (indices[i] != escapeIndex) {
+      output[i] = stats_.fromIndex(indices[i]);
+      continue;
+    }
+
+    if (bitPos + RAW_BITS > encoded.escapes.size() * 64) {
+      throw std::runtime_error("escape stream too short");
+    }
+    const size_t word = bitPos / 64;
+    const size_t shift = bitPos % 64;
+    uint64_t raw = encoded.escapes[word] >> shift;
+    if (shift + RAW_BITS > 64) {
+      raw |= encoded.escapes[word + 1] << (64 - shift);
+    }
+    bitPos += RAW_BITS;
+    // the low bits of raw are the value, in the two's complement of
+    // source_T for signed ones.
+    output[i] = static_cast<source_T>(raw);
+  }
+}
+
+}  // namespace rans
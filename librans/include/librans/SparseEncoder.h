@@ -0,0 +1,92 @@
+/*
+ * SparseEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "EncodedSparse.h"
+#include "Encoder.h"
+#include "OutputBuffer.h"
+#include "SparseSymbolStatistics.h"
+
+namespace rans {
+
+// Codes values through a SparseSymbolStatistics: values with an entry are
+// coded by their index, all others as the escape index plus the
+// 8 * sizeof(source_T) bits of the value.
+//
+// The escapes go to their own bit stream rather than between the words of the
+// interleaved states, so the inner loop of Encoder stays untouched. The
+// indices and the stream go to scratch buffers that are reused across calls.
+template <typename coder_T, typename stream_T, size_t N>
+class SparseEncoder {
+ public:
+  // stats has to outlive the encoder.
+  SparseEncoder(const SparseSymbolStatistics& stats, size_t probabilityBits);
+
+  template <typename source_T>
+  EncodedSparse<stream_T> encode(const source_T* begin,
+                                 const source_T* end) const;
+
+ private:
+  const SparseSymbolStatistics& stats_;
+  size_t probabilityBits_;
+  Encoder<coder_T, stream_T, N> encoder_;
+  mutable OutputArena<uint32_t> indexArena_;
+  mutable OutputArena<stream_T> arena_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+SparseEncoder<coder_T, stream_T, N>::SparseEncoder(
+    const SparseSymbolStatistics& stats, size_t probabilityBits)
+    : stats_(stats),
+      probabilityBits_(probabilityBits),
+      encoder_(stats.getIndexStatistics(), probabilityBits) {}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_T>
+EncodedSparse<stream_T> SparseEncoder<coder_T, stream_T, N>::encode(
+    const source_T* begin, const source_T* end) const {
+  const size_t numSymbols = end - begin;
+  const uint32_t escapeIndex = stats_.getEscapeIndex();
+  constexpr size_t RAW_BITS = 8 * sizeof(source_T);
+  constexpr uint64_t RAW_MASK = ~0ull >> (64 - RAW_BITS);
+
+  EncodedSparse<stream_T> encoded;
+  encoded.numSymbols = numSymbols;
+
+  const auto indexBuffer = indexArena_.acquire(numSymbols);
+  uint32_t* indices = indexBuffer->begin();
+  size_t bitPos = 0;
+  for (size_t i = 0; i < numSymbols; i++) {
+    const int64_t value = begin[i];
+    indices[i] = stats_.toIndex(value);
+    if (indices[i] != escapeIndex) {
+      continue;
+    }
+
+    const uint64_t raw = static_cast<uint64_t>(value) & RAW_MASK;
+    const size_t word = bitPos / 64;
+    const size_t shift = bitPos % 64;
+    encoded.escapes.resize((bitPos + RAW_BITS + 63) / 64, 0);
+    encoded.escapes[word] |= raw << shift;
+    if (shift + RAW_BITS > 64) {
+      encoded.escapes[word + 1] |= raw >> (64 - shift);
+    }
+    bitPos += RAW_BITS;
+    encoded.numEscapes++;
+  }
+
+  const auto buffer = arena_.acquire(
+      maxCompressedSize<coder_T, stream_T, N>(numSymbols, probabilityBits_));
+  stream_T* streamBegin = encoder_.encode(
+      indices, indices + numSymbols, buffer->begin(), buffer->end());
+  encoded.stream.assign(streamBegin, buffer->end());
+  return encoded;
+}
+
+}  // namespace rans
@@ -0,0 +1,85 @@
+/*
+ * SparseSymbolStatistics.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Statistics for huge, sparse alphabets.
+//
+// Only the maxSymbols most frequent values get an entry of their own. They are
+// numbered 0, 1, ... in increasing order of value and are followed by a single
+// escape index that stands for all remaining values, which are stored as the
+// raw bits of the source type instead. The dense SymbolStatistics over these
+// indices therefore has at most maxSymbols + 1 entries, no matter how far
+// apart the values are. The escape index always has a nonzero frequency, so
+// the statistics code any value, not only the ones they were built from.
+class SparseSymbolStatistics {
+ public:
+  template <typename source_IT>
+  SparseSymbolStatistics(source_IT begin, source_IT end, size_t maxSymbols);
+
+  // From a range of tokens, e.g. a std::vector, Span or StridedSpan.
+  template <typename range_T,
+            typename = decltype(std::declval<const range_T&>().begin())>
+  SparseSymbolStatistics(const range_T& tokens, size_t maxSymbols)
+      : SparseSymbolStatistics(tokens.begin(), tokens.end(), maxSymbols) {}
+
+  void rescaleFrequencyTable(uint32_t newCumulatedFrequency);
+
+  // Statistics over the indices 0 ... getEscapeIndex().
+  const SymbolStatistics& getIndexStatistics() const;
+
+  uint32_t getEscapeIndex() const;
+
+  // Index of a value, getEscapeIndex() for values without an entry.
+  inline uint32_t toIndex(int64_t value) const;
+
+  // Value of an index other than the escape index.
+  inline int64_t fromIndex(uint32_t index) const;
+
+ private:
+  // counts holds every distinct value with its number of occurrences.
+  void build(std::vector<std::pair<int64_t, uint64_t>> counts,
+             size_t maxSymbols);
+
+  std::vector<int64_t> values_;
+  std::unordered_map<int64_t, uint32_t> indices_;
+  SymbolStatistics indexStatistics_;
+};
+
+template <typename source_IT>
+SparseSymbolStatistics::SparseSymbolStatistics(source_IT begin, source_IT end,
+                                               size_t maxSymbols)
+    : values_(), indices_(), indexStatistics_(0, {0}) {
+  // memory is proportional to the number of distinct values, not to their
+  // range.
+  std::unordered_map<int64_t, uint64_t> histogram;
+  for (source_IT it = begin; it != end; ++it) {
+    histogram[static_cast<int64_t>(*it)]++;
+  }
+  build(std::vector<std::pair<int64_t, uint64_t>>(histogram.begin(),
+                                                  histogram.end()),
+        maxSymbols);
+}
+
+inline uint32_t SparseSymbolStatistics::toIndex(int64_t value) const {
+  const auto index = indices_.find(value);
+  return index == indices_.end() ? values_.size() : index->second;
+}
+
+inline int64_t SparseSymbolStatistics::fromIndex(uint32_t index) const {
+  return values_[index];
+}
+
+}  // namespace rans
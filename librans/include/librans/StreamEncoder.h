@@ -0,0 +1,124 @@
+/*
+ * StreamEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Encoder.h"
+#include "OutputBuffer.h"
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Encodes an unbounded input that arrives front to back in pieces of any size,
+// with memory bounded by the window size.
+//
+// rANS codes backwards, so symbols are collected in a window of windowSize
+// symbols. Every full window is coded on its own with an Encoder<coder_T,
+// stream_T, N> and handed to the sink, the last, possibly shorter window on
+// flush(). Each chunk is an independent block: decode it with Decoder<coder_T,
+// stream_T, N>, or append chunks to EncodedBlocks for a BlockDecoder.
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+class StreamEncoder {
+ public:
+  // Receives the stream [begin, end) of a chunk of numSymbols symbols. The
+  // stream is only valid during the call.
+  using Sink = std::function<void(const stream_T* begin, const stream_T* end,
+                                  size_t numSymbols)>;
+
+  StreamEncoder(const SymbolStatistics& stats, size_t probabilityBits,
+                size_t windowSize, Sink sink);
+
+  // Appends [begin, end) to the input, emitting every window that fills up.
+  template <typename source_IT>
+  void write(source_IT begin, source_IT end);
+
+  // Emits the symbols written since the last chunk, if any. Call it at the end
+  // of the input, symbols still buffered on destruction are lost.
+  void flush();
+
+  size_t getWindowSize() const;
+
+ private:
+  void emit();
+
+  Encoder<coder_T, stream_T, N> encoder_;
+  size_t windowSize_;
+  Sink sink_;
+  std::vector<source_T> window_;
+  OutputBuffer<stream_T> buffer_;
+};
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+StreamEncoder<coder_T, stream_T, N, source_T>::StreamEncoder(
+    const SymbolStatistics& stats, size_t probabilityBits, size_t windowSize,
+    Sink sink)
+    : encoder_(stats, probabilityBits),
+      windowSize_(windowSize),
+      sink_(std::move(sink)) {
+  if (windowSize_ == 0) {
+    throw std::runtime_error("window has to hold at least one symbol");
+  }
+  window_.reserve(windowSize_);
+  buffer_.reserve(
+      maxCompressedSize<coder_T, stream_T, N>(windowSize_, probabilityBits));
+}
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+template <typename source_IT>
+void StreamEncoder<coder_T, stream_T, N, source_T>::write(source_IT begin,
+                                                          source_IT end) {
+  using category = typename std::iterator_traits<source_IT>::iterator_category;
+  if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+    while (begin != end) {
+      const size_t count = std::min(static_cast<size_t>(end - begin),
+                                    windowSize_ - window_.size());
+      window_.insert(window_.end(), begin, begin + count);
+      begin += count;
+      if (window_.size() == windowSize_) {
+        emit();
+      }
+    }
+  } else {
+    for (; begin != end; ++begin) {
+      window_.push_back(*begin);
+      if (window_.size() == windowSize_) {
+        emit();
+      }
+    }
+  }
+}
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+void StreamEncoder<coder_T, stream_T, N, source_T>::flush() {
+  if (!window_.empty()) {
+    emit();
+  }
+}
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+size_t StreamEncoder<coder_T, stream_T, N, source_T>::getWindowSize() const {
+  return windowSize_;
+}
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+void StreamEncoder<coder_T, stream_T, N, source_T>::emit() {
+  const stream_T* streamBegin = encoder_.encode(
+      window_.begin(), window_.end(), buffer_.begin(), buffer_.end());
+  const size_t numSymbols = window_.size();
+  window_.clear();
+  sink_(streamBegin, buffer_.end(), numSymbols);
+}
+
+}  // namespace rans
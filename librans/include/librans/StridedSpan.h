@@ -0,0 +1,165 @@
+/*
+ * StridedSpan.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "Span.h"
+
+namespace rans {
+
+// Random access iterator over elements of T that are stride bytes apart, e.g.
+// one field of an array of structs. All statistics, encoders and decoders
+// that take iterators accept it, so a field is coded in place instead of
+// being gathered into a vector of its own first.
+template <typename T>
+class StridedIterator {
+  using byte_t = std::conditional_t<std::is_const_v<T>, const char, char>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_cv_t<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  constexpr StridedIterator() = default;
+  constexpr StridedIterator(T* element, difference_type stride)
+      : element_(reinterpret_cast<byte_t*>(element)), stride_(stride) {}
+
+  // StridedIterator<const T> from StridedIterator<T>.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr StridedIterator(const StridedIterator<U>& other)
+      : StridedIterator(other.operator->(), other.stride()) {}
+
+  constexpr difference_type stride() const { return stride_; }
+
+  reference operator*() const { return *operator->(); }
+  pointer operator->() const { return reinterpret_cast<pointer>(element_); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  StridedIterator& operator++() {
+    element_ += stride_;
+    return *this;
+  }
+  StridedIterator operator++(int) {
+    StridedIterator old = *this;
+    ++*this;
+    return old;
+  }
+  StridedIterator& operator--() {
+    element_ -= stride_;
+    return *this;
+  }
+  StridedIterator operator--(int) {
+    StridedIterator old = *this;
+    --*this;
+    return old;
+  }
+  StridedIterator& operator+=(difference_type n) {
+    element_ += n * stride_;
+    return *this;
+  }
+  StridedIterator& operator-=(difference_type n) {
+    element_ -= n * stride_;
+    return *this;
+  }
+
+  friend StridedIterator operator+(StridedIterator it, difference_type n) {
+    return it += n;
+  }
+  friend StridedIterator operator+(difference_type n, StridedIterator it) {
+    return it += n;
+  }
+  friend StridedIterator operator-(StridedIterator it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const StridedIterator& a,
+                                   const StridedIterator& b) {
+    return (a.element_ - b.element_) / a.stride_;
+  }
+
+  friend bool operator==(const StridedIterator& a, const StridedIterator& b) {
+    return a.element_ == b.element_;
+  }
+  friend bool operator!=(const StridedIterator& a, const StridedIterator& b) {
+    return a.element_ != b.element_;
+  }
+  friend bool operator<(const StridedIterator& a, const StridedIterator& b) {
+    return a - b < 0;
+  }
+  friend bool operator>(const StridedIterator& a, const StridedIterator& b) {
+    return b < a;
+  }
+  friend bool operator<=(const StridedIterator& a, const StridedIterator& b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const StridedIterator& a, const StridedIterator& b) {
+    return !(a < b);
+  }
+
+ private:
+  byte_t* element_ = nullptr;
+  difference_type stride_ = sizeof(T);
+};
+
+// size elements of T, stride bytes apart, starting at first.
+template <typename T>
+class StridedSpan {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using iterator = StridedIterator<T>;
+
+  constexpr StridedSpan() = default;
+  constexpr StridedSpan(T* first, size_t size, std::ptrdiff_t stride)
+      : first_(first), size_(size), stride_(stride) {}
+
+  iterator begin() const { return iterator(first_, stride_); }
+  iterator end() const { return begin() + size_; }
+
+  constexpr size_t size() const { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
+  constexpr std::ptrdiff_t stride() const { return stride_; }
+
+  T& operator[](size_t index) const { return begin()[index]; }
+
+ private:
+  T* first_ = nullptr;
+  size_t size_ = 0;
+  std::ptrdiff_t stride_ = sizeof(T);
+};
+
+// The field member of every record, for reading and writing in place:
+//
+//   struct Cluster { uint16_t pad; uint8_t time; ... };
+//   std::vector<Cluster> clusters = ...;
+//   const SymbolStatistics stats(fieldOf(clusters, &Cluster::time));
+template <typename Record, typename Field>
+StridedSpan<Field> fieldOf(Span<Record> records, Field Record::*member) {
+  return StridedSpan<Field>(records.empty() ? nullptr : &(records[0].*member),
+                            records.size(), sizeof(Record));
+}
+
+template <typename Record, typename Field>
+StridedSpan<const Field> fieldOf(Span<const Record> records,
+                                 Field Record::*member) {
+  return StridedSpan<const Field>(
+      records.empty() ? nullptr : &(records[0].*member), records.size(),
+      sizeof(Record));
+}
+
+template <typename Container, typename Record, typename Field>
+auto fieldOf(Container& records, Field Record::*member) {
+  using record_t = std::remove_pointer_t<decltype(records.data())>;
+  return fieldOf(Span<record_t>(records), member);
+}
+
+}  // namespace rans
@@ -0,0 +1,57 @@
+/*
+ * SymbolAdaptiveDecoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "AdaptiveCDF.h"
+#include "Decoder.h"
+#include "FixedScaleCoder.h"
+
+namespace rans {
+
+// Decodes a stream written by SymbolAdaptiveEncoder<coder_T, stream_T, N>,
+// adapting the same AdaptiveCDF after every decoded symbol.
+template <typename coder_T, typename stream_T, size_t N>
+class SymbolAdaptiveDecoder {
+  static_assert(N > 0, "need at least one state");
+
+ public:
+  explicit SymbolAdaptiveDecoder(size_t numSymbols);
+
+  // Decodes numSymbols symbols from the stream starting at input into output.
+  template <typename source_IT>
+  void decode(const stream_T* input, source_IT output,
+              size_t numSymbols) const;
+
+ private:
+  AdaptiveCDF initialCDF_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+SymbolAdaptiveDecoder<coder_T, stream_T, N>::SymbolAdaptiveDecoder(
+    size_t numSymbols)
+    : initialCDF_(numSymbols) {}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+void SymbolAdaptiveDecoder<coder_T, stream_T, N>::decode(
+    const stream_T* input, source_IT output, size_t numSymbols) const {
+  constexpr uint32_t probabilityBits = AdaptiveCDF::PROBABILITY_BITS;
+  AdaptiveCDF cdf = initialCDF_;
+
+  const FixedScaleCoder<coder_T, stream_T, probabilityBits> coder{};
+  decodeInterleaved<coder_T, N>(
+      coder, input, numSymbols, [&](State<coder_T>* state) {
+        const uint32_t symbol = cdf.find(coder.decGet(state));
+        *output++ = symbol;
+        coder.decAdvanceStep(state, cdf.start(symbol), cdf.frequency(symbol));
+        cdf.update(symbol);
+      });
+}
+
+}  // namespace rans
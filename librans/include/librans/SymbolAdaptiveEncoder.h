@@ -0,0 +1,83 @@
+/*
+ * SymbolAdaptiveEncoder.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "AdaptiveCDF.h"
+#include "Coder.h"
+#include "Encoder.h"
+
+namespace rans {
+
+// Encodes symbols 0, ..., numSymbols - 1 of a small alphabet with N
+// interleaved rANS states and an AdaptiveCDF instead of static statistics, so
+// neither a histogram pass nor a dictionary is needed. The layout of states
+// and symbols is the one of Encoder.
+//
+// The model has to see the symbols in order while rANS encodes them in
+// reverse, so start and frequency of every symbol are recorded in a forward
+// pass first.
+template <typename coder_T, typename stream_T, size_t N>
+class SymbolAdaptiveEncoder {
+  static_assert(N > 0, "need at least one state");
+
+ public:
+  explicit SymbolAdaptiveEncoder(size_t numSymbols);
+
+  // Encodes [begin,end) into the buffer [outputBegin,outputEnd). The stream is
+  // written backwards from outputEnd, the return value is its start.
+  template <typename source_IT>
+  stream_T* encode(const source_IT begin, const source_IT end,
+                   stream_T* outputBegin, stream_T* outputEnd) const;
+
+ private:
+  using Rans = Coder<coder_T, stream_T>;
+
+  AdaptiveCDF initialCDF_;
+};
+
+template <typename coder_T, typename stream_T, size_t N>
+SymbolAdaptiveEncoder<coder_T, stream_T, N>::SymbolAdaptiveEncoder(
+    size_t numSymbols)
+    : initialCDF_(numSymbols) {}
+
+template <typename coder_T, typename stream_T, size_t N>
+template <typename source_IT>
+stream_T* SymbolAdaptiveEncoder<coder_T, stream_T, N>::encode(
+    const source_IT begin, const source_IT end, stream_T* outputBegin,
+    stream_T* outputEnd) const {
+  constexpr uint32_t probabilityBits = AdaptiveCDF::PROBABILITY_BITS;
+  const size_t numSymbols = std::distance(begin, end);
+
+  // forward pass: start in the upper, frequency in the lower 16 bits.
+  std::vector<uint32_t> intervals;
+  intervals.reserve(numSymbols);
+  AdaptiveCDF cdf = initialCDF_;
+  for (source_IT it = begin; it != end; ++it) {
+    const int64_t symbol = *it;
+    if (symbol < 0 || symbol >= static_cast<int64_t>(cdf.size())) {
+      throw std::runtime_error("symbol out of range of adaptive model");
+    }
+    intervals.push_back(cdf.start(symbol) << 16 | cdf.frequency(symbol));
+    cdf.update(symbol);
+  }
+
+  auto it = intervals.end();
+  return encodeInterleaved<coder_T, N>(
+      numSymbols, outputBegin, outputEnd,
+      [&](State<coder_T>* state, stream_T** pptr) {
+        const uint32_t interval = *--it;
+        Rans::encPut(state, pptr, interval >> 16, interval & 0xffff,
+                     probabilityBits);
+      });
+}
+
+}  // namespace rans
@@ -10,11 +10,18 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "rapidjson/document.h"
 
+#include "Histogram.h"
+#include "ThreadPool.h"
+
 namespace json = rapidjson;
 
 namespace rans {
@@ -37,15 +44,43 @@ class SymbolStatistics {
   };
 
  public:
-  template <typename T>
-  explicit SymbolStatistics(const std::vector<T>& tokens, size_t range = 0)
+  // From the tokens in [begin, end), any random access iterators.
+  template <typename source_IT,
+            typename = typename std::iterator_traits<
+                source_IT>::iterator_category>
+  SymbolStatistics(source_IT begin, source_IT end, size_t range = 0)
+      : min_(0), max_(0), frequencyTable_(), cumulativeFrequencyTable_() {
+    buildFrequencyTable(begin, end, range, nullptr);
+    buildCumulativeFrequencyTable();
+  }
+
+  // From a range of tokens, e.g. a std::vector, Span or StridedSpan.
+  template <typename range_T,
+            typename = decltype(std::declval<const range_T&>().begin())>
+  explicit SymbolStatistics(const range_T& tokens, size_t range = 0)
+      : SymbolStatistics(tokens.begin(), tokens.end(), range) {}
+
+  // Same, but large inputs are counted in parallel on pool.
+  template <typename source_IT,
+            typename = typename std::iterator_traits<
+                source_IT>::iterator_category>
+  SymbolStatistics(source_IT begin, source_IT end, size_t range,
+                   ThreadPool& pool)
       : min_(0), max_(0), frequencyTable_(), cumulativeFrequencyTable_() {
-    buildFrequencyTable(tokens, range);
+    buildFrequencyTable(begin, end, range, &pool);
     buildCumulativeFrequencyTable();
   }
 
+  template <typename range_T,
+            typename = decltype(std::declval<const range_T&>().begin())>
+  SymbolStatistics(const range_T& tokens, size_t range, ThreadPool& pool)
+      : SymbolStatistics(tokens.begin(), tokens.end(), range, pool) {}
+
   explicit SymbolStatistics(const json::Value& document);
 
+  // from an already known frequency table of the symbols min, min + 1, ...
+  SymbolStatistics(int min, std::vector<uint32_t> frequencies);
+
   ~SymbolStatistics() = default;
   SymbolStatistics(const SymbolStatistics& stats) = default;
   SymbolStatistics(SymbolStatistics&& stats) = default;
@@ -75,8 +110,9 @@ class SymbolStatistics {
  private:
   void buildCumulativeFrequencyTable();
 
-  template <typename T>
-  void buildFrequencyTable(const std::vector<T>& symbols, size_t range);
+  template <typename source_IT>
+  void buildFrequencyTable(source_IT begin, source_IT end, size_t range,
+                           ThreadPool* pool);
 
   int min_ = 0;
   int max_ = 0;
@@ -84,33 +120,62 @@ class SymbolStatistics {
   std::vector<uint32_t> cumulativeFrequencyTable_;
 };
 
-template <typename T>
-void SymbolStatistics::buildFrequencyTable(const std::vector<T>& tokens,
-                                           size_t range) {
-  // find min_ and max_
-  const auto minmax = std::minmax_element(tokens.begin(), tokens.end());
+template <typename source_IT>
+void SymbolStatistics::buildFrequencyTable(source_IT begin, source_IT end,
+                                           size_t range, ThreadPool* pool) {
+  using T = token_t<source_IT>;
+  if (begin == end) {
+    throw std::runtime_error("no tokens to build statistics from");
+  }
 
+  // find min_ and max_. For narrow types this is fused with counting: every
+  // possible value is counted and min and max are the outermost values seen.
+  std::pair<int64_t, int64_t> minmax;
+  std::vector<uint32_t> frequencies;
+  int64_t frequenciesMin = 0;
+  if constexpr (isNarrowSource<T>()) {
+    frequenciesMin = std::numeric_limits<T>::min();
+    frequencies = histogram(begin, end, frequenciesMin,
+                            static_cast<size_t>(1) << (8 * sizeof(T)), pool);
+    const auto isSet = [](uint32_t frequency) { return frequency > 0; };
+    minmax.first =
+        frequenciesMin +
+        (std::find_if(frequencies.begin(), frequencies.end(), isSet) -
+         frequencies.begin());
+    minmax.second =
+        frequenciesMin + (frequencies.rend() - 1 -
+                          std::find_if(frequencies.rbegin(),
+                                       frequencies.rend(), isSet));
+  } else {
+    minmax = tokenRange(begin, end, pool);
+  }
+
+  int64_t min = minmax.first;
+  int64_t max = minmax.second;
   if (range > 0) {
-    min_ = 0;
-    max_ = (1 << range) - 1;
+    min = 0;
+    max = (1 << range) - 1;
 
     // do checks
-    if (static_cast<unsigned int>(min_) > *minmax.first) {
+    if (min > minmax.first) {
       throw std::runtime_error("min of data too small for given minimum");
     }
 
-    if (static_cast<unsigned int>(max_) < *minmax.second) {
+    if (max < minmax.second) {
       throw std::runtime_error("max of data too big for given maximum");
     }
-  } else {
-    min_ = *minmax.first;
-    max_ = *minmax.second;
   }
-
-  frequencyTable_.resize(std::abs(max_ - min_) + 1, 0);
-
-  for (auto token : tokens) {
-    frequencyTable_[token - min_]++;
+  min_ = min;
+  max_ = max;
+
+  if constexpr (isNarrowSource<T>()) {
+    // cut out [min, max], all counts outside of minmax are zero anyway.
+    frequencyTable_.resize(max - min + 1, 0);
+    std::copy(frequencies.begin() + (minmax.first - frequenciesMin),
+              frequencies.begin() + (minmax.second - frequenciesMin) + 1,
+              frequencyTable_.begin() + (minmax.first - min));
+  } else {
+    frequencyTable_ = histogram(begin, end, min, max - min + 1, pool);
   }
 }
 
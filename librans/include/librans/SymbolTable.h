@@ -36,4 +36,23 @@ private:
 	int min_;
 	std::vector<T> symbolTable_;
 };
+
+// Non owning view of a symbol table, e.g. stored in a BinaryDictionary.
+template <typename T>
+class SymbolTableView {
+public:
+	SymbolTableView(const T* symbolTable, int min): min_(min), symbolTable_(symbolTable)
+	{
+	}
+
+	const T& operator[](int index) const
+	{
+
+		return symbolTable_[index - min_];
+	}
+
+private:
+	int min_;
+	const T* symbolTable_;
+};
 }  // namespace rans
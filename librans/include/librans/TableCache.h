@@ -0,0 +1,159 @@
+/*
+ * TableCache.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BinaryDictionary.h"
+#include "SymbolStatistics.h"
+
+namespace rans {
+
+// Immutable encoder and decoder tables of one dictionary, stored as a
+// BinaryDictionary owned by this object.
+class CachedTables {
+ public:
+  explicit CachedTables(std::vector<uint64_t> dictionary);
+
+  CachedTables(const CachedTables&) = delete;
+  CachedTables& operator=(const CachedTables&) = delete;
+
+  const BinaryDictionaryView& getView() const;
+
+  size_t getProbabilityBits() const;
+
+  template <typename coder_T>
+  SymbolTableView<EncoderSymbol<coder_T>> getEncoderTable() const;
+
+  DecoderTableView getDecoderTable() const;
+
+  // Whether these are the tables of stats at probabilityBits for coder_T.
+  template <typename coder_T>
+  bool matches(const SymbolStatistics& stats, size_t probabilityBits) const;
+
+ private:
+  friend class TableCache;
+
+  bool matches(const SymbolStatistics& stats, size_t probabilityBits,
+               size_t coderBits, size_t encoderSymbolBytes) const;
+
+  std::vector<uint64_t> dictionary_;
+  BinaryDictionaryView view_;
+};
+
+// Shares prebuilt tables between coders using the same dictionary.
+//
+// Tables are keyed by a hash of the normalized frequencies, min,
+// probabilityBits and the width of the coder, so building them is paid once
+// per dictionary instead of once per coding job. Hash collisions are resolved
+// by comparing the frequencies.
+//
+// With a directory, tables missing in memory are looked up as
+// <directory>/<key>.rdct binary dictionaries before they are built, and newly
+// built tables are written there, so they survive the process. Files that
+// fail validation or belong to another dictionary are rebuilt.
+//
+// All methods are thread safe. Tables are built without holding the lock;
+// if two threads miss on the same dictionary, the first one to finish wins.
+class TableCache {
+ public:
+  explicit TableCache(std::string directory = std::string());
+
+  TableCache(const TableCache&) = delete;
+  TableCache& operator=(const TableCache&) = delete;
+
+  // stats have to be normalized to probabilityBits.
+  template <typename coder_T>
+  std::shared_ptr<const CachedTables> get(const SymbolStatistics& stats,
+                                          size_t probabilityBits);
+
+  template <typename coder_T>
+  static uint64_t key(const SymbolStatistics& stats, size_t probabilityBits);
+
+  // number of tables held in memory.
+  size_t size() const;
+
+  void clear();
+
+  inline static const std::string FILE_EXTENSION = ".rdct";
+
+ private:
+  using Builder = std::vector<uint8_t> (*)(const SymbolStatistics&, size_t);
+
+  // coderBits and encoderSymbolBytes tell the encoder tables of different
+  // coders apart.
+  struct Kind {
+    size_t coderBits;
+    size_t encoderSymbolBytes;
+  };
+
+  template <typename coder_T>
+  static constexpr Kind kind() {
+    return {sizeof(coder_T) * 8, sizeof(EncoderSymbol<coder_T>)};
+  }
+
+  static uint64_t key(const SymbolStatistics& stats, size_t probabilityBits,
+                      Kind kind);
+
+  std::shared_ptr<const CachedTables> get(const SymbolStatistics& stats,
+                                          size_t probabilityBits, Kind kind,
+                                          Builder build);
+
+  std::shared_ptr<const CachedTables> find(uint64_t key,
+                                           const SymbolStatistics& stats,
+                                           size_t probabilityBits,
+                                           Kind kind) const;
+
+  static std::shared_ptr<const CachedTables> load(
+      const std::string& path, const SymbolStatistics& stats,
+      size_t probabilityBits, Kind kind);
+
+  static void store(const std::string& path,
+                    const std::vector<uint8_t>& dictionary);
+
+  std::string path(uint64_t key) const;
+
+  std::string directory_;
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<std::shared_ptr<const CachedTables>>>
+      tables_;
+};
+
+template <typename coder_T>
+SymbolTableView<EncoderSymbol<coder_T>> CachedTables::getEncoderTable() const {
+  return view_.getEncoderTable<coder_T>();
+}
+
+template <typename coder_T>
+bool CachedTables::matches(const SymbolStatistics& stats,
+                           size_t probabilityBits) const {
+  return matches(stats, probabilityBits, sizeof(coder_T) * 8,
+                 sizeof(EncoderSymbol<coder_T>));
+}
+
+template <typename coder_T>
+uint64_t TableCache::key(const SymbolStatistics& stats,
+                         size_t probabilityBits) {
+  return key(stats, probabilityBits, kind<coder_T>());
+}
+
+template <typename coder_T>
+std::shared_ptr<const CachedTables> TableCache::get(
+    const SymbolStatistics& stats, size_t probabilityBits) {
+  return get(stats, probabilityBits, kind<coder_T>(),
+             [](const SymbolStatistics& stats, size_t probabilityBits) {
+               return BinaryDictionary::serialize<coder_T>(stats,
+                                                           probabilityBits);
+             });
+}
+
+}  // namespace rans
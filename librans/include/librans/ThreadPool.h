@@ -0,0 +1,76 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace rans {
+
+// Fixed size pool of worker threads executing submitted tasks in FIFO order.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  // Queues task for execution. Exceptions thrown by the task are rethrown by
+  // the returned future.
+  template <typename F>
+  std::future<std::invoke_result_t<F>> submit(F&& task);
+
+  size_t size() const;
+
+ private:
+  void work();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_ = false;
+};
+
+// Waits for all tasks and rethrows the first exception. Tasks usually refer to
+// the caller's stack, so none may be left running when unwinding.
+template <typename T>
+void waitAll(std::vector<std::future<T>>& tasks) {
+  for (auto& task : tasks) {
+    task.wait();
+  }
+  for (auto& task : tasks) {
+    task.get();
+  }
+}
+
+template <typename F>
+std::future<std::invoke_result_t<F>> ThreadPool::submit(F&& task) {
+  using result_t = std::invoke_result_t<F>;
+  // std::function needs a copyable target.
+  auto packagedTask =
+      std::make_shared<std::packaged_task<result_t()>>(std::forward<F>(task));
+  std::future<result_t> result = packagedTask->get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.emplace([packagedTask]() { (*packagedTask)(); });
+  }
+  condition_.notify_one();
+  return result;
+}
+
+}  // namespace rans
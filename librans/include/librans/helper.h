@@ -7,6 +7,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
 namespace rans {
 
 template<typename T>
@@ -14,6 +18,50 @@ constexpr bool needs64Bit(){
 	return sizeof(T)>4;
 }
 
+template<typename Stream_t>
+constexpr bool isWordStream(){
+	return sizeof(Stream_t)==2;
+}
+
+namespace internal {
+template<typename F, size_t... I>
+inline void unroll(F&& f, std::index_sequence<I...>){
+	(f(std::integral_constant<size_t, I>{}), ...);
+}
+
+template<size_t N, typename F, size_t... I>
+inline void unrollReverse(F&& f, std::index_sequence<I...>){
+	(f(std::integral_constant<size_t, N - 1 - I>{}), ...);
+}
+
+template<uint32_t Min, typename F, size_t... I>
+inline bool withScaleBits(uint32_t scaleBits, F&& f, std::index_sequence<I...>){
+	return ((scaleBits == Min + I ? (f(std::integral_constant<uint32_t, Min + I>{}), true) : false) || ...);
+}
+}  // namespace internal
+
+// Calls f(std::integral_constant<size_t, I>{}) for I = 0, ..., N-1 in order,
+// unrolled at compile time.
+template<size_t N, typename F>
+inline void unroll(F&& f){
+	internal::unroll(f, std::make_index_sequence<N>{});
+}
+
+// Same as unroll, but for I = N-1, ..., 0.
+template<size_t N, typename F>
+inline void unrollReverse(F&& f){
+	internal::unrollReverse<N>(f, std::make_index_sequence<N>{});
+}
+
+// Calls f(std::integral_constant<uint32_t, scaleBits>{}) if scaleBits is in
+// [Min, Max], turning a run time probability bit count into a compile time one.
+// Each value instantiates f once. Returns false, without calling f, otherwise.
+template<uint32_t Min, uint32_t Max, typename F>
+inline bool withScaleBits(uint32_t scaleBits, F&& f){
+	static_assert(Min <= Max, "empty range of scale bits");
+	return internal::withScaleBits<Min>(scaleBits, f, std::make_index_sequence<Max - Min + 1>{});
+}
+
 }  // namespace rans
 
 
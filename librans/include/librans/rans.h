@@ -7,10 +7,48 @@
 
 #pragma once
 
+#include "AdaptiveBlockDecoder.h"
+#include "AdaptiveBlockEncoder.h"
+#include "AdaptiveCDF.h"
+#include "AdaptiveDictionary.h"
+#include "AliasEncoderSymbol.h"
+#include "AliasTable.h"
+#include "BinaryDictionary.h"
+#include "BlockDecoder.h"
+#include "BlockEncoder.h"
+#include "ByteIO.h"
 #include "Coder.h"
+#include "ColumnDecoder.h"
+#include "ColumnEncoder.h"
+#include "ColumnFrame.h"
+#include "ContextDecoder.h"
+#include "ContextEncoder.h"
+#include "ContextStatistics.h"
+#include "Decoder.h"
 #include "DecoderSymbol.h"
+#include "DecoderTable.h"
+#include "Encoder.h"
+#include "EncodedSparse.h"
 #include "EncoderSymbol.h"
 #include "Dictionary.h"
+#include "FixedScaleCoder.h"
+#include "Frame.h"
+#include "Histogram.h"
+#include "MappedFile.h"
+#include "OutputBuffer.h"
+#include "SIMDDecoder.h"
+#include "SIMDEncoder.h"
+#include "SIMDLevel.h"
+#include "SparseDecoder.h"
+#include "SparseEncoder.h"
+#include "SparseSymbolStatistics.h"
+#include "Span.h"
+#include "StreamEncoder.h"
+#include "StridedSpan.h"
+#include "SymbolAdaptiveDecoder.h"
+#include "SymbolAdaptiveEncoder.h"
 #include "SymbolStatistics.h"
 #include "SymbolTable.h"
+#include "TableCache.h"
+#include "ThreadPool.h"
 
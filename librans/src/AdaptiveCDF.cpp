@@ -0,0 +1,29 @@
+/*
+ * AdaptiveCDF.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <stdexcept>
+
+#include "librans/AdaptiveCDF.h"
+
+namespace rans {
+
+AdaptiveCDF::AdaptiveCDF(size_t numSymbols) : numSymbols_(numSymbols) {
+  if (numSymbols < 2 || numSymbols > MAX_SYMBOLS) {
+    throw std::runtime_error("alphabet size not supported by adaptive model");
+  }
+  // larger alphabets adapt slower, as in AV1.
+  baseRate_ = numSymbols < 4 ? 4 : 5;
+
+  for (size_t i = 0; i < numSymbols_; i++) {
+    starts_[i] = i * scale() / numSymbols_ + i;
+  }
+  starts_[numSymbols_] = 1u << PROBABILITY_BITS;
+  for (size_t i = numSymbols_ + 1; i < MAX_SYMBOLS + 8; i++) {
+    starts_[i] = 0xffff;
+  }
+}
+
+}  // namespace rans
@@ -0,0 +1,159 @@
+/*
+ * AdaptiveDictionary.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "librans/AdaptiveDictionary.h"
+#include "librans/Frame.h"
+
+namespace rans {
+
+AdaptiveDictionary::AdaptiveDictionary(size_t probabilityBits)
+    : probabilityBits_(probabilityBits), table_(nullptr) {}
+
+TableUpdate AdaptiveDictionary::encodeUpdate(
+    int min, const std::vector<uint32_t>& counts,
+    std::vector<uint8_t>& updates) {
+  if (counts.size() > MAX_DICTIONARY_SIZE) {
+    throw std::runtime_error("symbol range too large for a table update");
+  }
+  const double reuseCost =
+      table_ ? codingCost(min, counts, *table_)
+             : std::numeric_limits<double>::infinity();
+
+  auto table = std::make_shared<SymbolStatistics>(min, counts);
+  table->rescaleFrequencyTable(static_cast<uint32_t>(1) << probabilityBits_);
+
+  std::vector<uint8_t> replace;
+  std::vector<uint8_t> delta;
+  ByteWriter replaceWriter(replace);
+  ByteWriter deltaWriter(delta);
+  std::vector<uint64_t> frequencies;
+  std::vector<uint64_t> differences;
+  frequencies.reserve(table->size());
+  differences.reserve(table->size());
+  int symbol = table->minSymbol();
+  for (const auto& entry : *table) {
+    const int64_t difference =
+        static_cast<int64_t>(entry.first) - currentFrequency(symbol++);
+    frequencies.push_back(entry.first);
+    differences.push_back(zigZagEncode(difference));
+  }
+  for (auto writer : {&replaceWriter, &deltaWriter}) {
+    writer->putZigZag(table->minSymbol());
+    writer->putVarint(table->size());
+  }
+  replaceWriter.putRunLengthVarints(frequencies);
+  deltaWriter.putRunLengthVarints(differences);
+
+  const bool useDelta = table_ && delta.size() < replace.size();
+  const std::vector<uint8_t>& update = useDelta ? delta : replace;
+  const double updateCost =
+      codingCost(min, counts, *table) + 8.0 * update.size();
+
+  if (reuseCost <= updateCost) {
+    updates.push_back(static_cast<uint8_t>(TableUpdate::Reuse));
+    return TableUpdate::Reuse;
+  }
+  const TableUpdate mode =
+      useDelta ? TableUpdate::Delta : TableUpdate::Replace;
+  updates.push_back(static_cast<uint8_t>(mode));
+  updates.insert(updates.end(), update.begin(), update.end());
+  table_ = std::move(table);
+  return mode;
+}
+
+TableUpdate AdaptiveDictionary::decodeUpdate(ByteReader& reader) {
+  const uint8_t mode = reader.get<uint8_t>();
+  if (mode == static_cast<uint8_t>(TableUpdate::Reuse)) {
+    if (!table_) {
+      throw std::runtime_error("corrupt data: no table to reuse");
+    }
+    return TableUpdate::Reuse;
+  }
+  if (mode != static_cast<uint8_t>(TableUpdate::Delta) &&
+      mode != static_cast<uint8_t>(TableUpdate::Replace)) {
+    throw std::runtime_error("corrupt data: invalid table update");
+  }
+  if (mode == static_cast<uint8_t>(TableUpdate::Delta) && !table_) {
+    throw std::runtime_error("corrupt data: no table to update");
+  }
+
+  const int64_t min = reader.getZigZag();
+  const uint64_t numFrequencies = reader.getVarint();
+  // a run of zeros codes any number of frequencies in a few bytes, so their
+  // number is bounded like that of a dictionary in a frame.
+  if (numFrequencies == 0 || numFrequencies > MAX_DICTIONARY_SIZE ||
+      min < std::numeric_limits<int>::min() ||
+      min > std::numeric_limits<int>::max() ||
+      numFrequencies - 1 >
+          static_cast<uint64_t>(std::numeric_limits<int>::max() - min)) {
+    throw std::runtime_error("corrupt data: invalid table update");
+  }
+  const std::vector<uint64_t> values =
+      reader.getRunLengthVarints(numFrequencies);
+
+  std::vector<uint32_t> frequencies;
+  frequencies.reserve(values.size());
+  uint64_t cumulatedFrequency = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    int64_t frequency = values[i];
+    if (mode == static_cast<uint8_t>(TableUpdate::Delta)) {
+      frequency = currentFrequency(static_cast<int>(min + i)) +
+                  zigZagDecode(values[i]);
+    }
+    if (frequency < 0 || frequency > std::numeric_limits<uint32_t>::max()) {
+      throw std::runtime_error("corrupt data: invalid table update");
+    }
+    cumulatedFrequency += frequency;
+    frequencies.push_back(frequency);
+  }
+  if (cumulatedFrequency != static_cast<uint64_t>(1) << probabilityBits_) {
+    throw std::runtime_error("corrupt data: invalid table update");
+  }
+
+  table_ =
+      std::make_shared<const SymbolStatistics>(min, std::move(frequencies));
+  return static_cast<TableUpdate>(mode);
+}
+
+std::shared_ptr<const SymbolStatistics> AdaptiveDictionary::getTable() const {
+  return table_;
+}
+
+size_t AdaptiveDictionary::getProbabilityBits() const {
+  return probabilityBits_;
+}
+
+double AdaptiveDictionary::codingCost(int min,
+                                      const std::vector<uint32_t>& counts,
+                                      const SymbolStatistics& table) const {
+  double bits = 0;
+  for (size_t i = 0; i < counts.size(); i++) {
+    if (counts[i] == 0) {
+      continue;
+    }
+    const int symbol = min + static_cast<int>(i);
+    if (symbol < table.minSymbol() || symbol > table.maxSymbol() ||
+        table[symbol].first == 0) {
+      return std::numeric_limits<double>::infinity();
+    }
+    bits += counts[i] * (probabilityBits_ - std::log2(table[symbol].first));
+  }
+  return bits;
+}
+
+uint32_t AdaptiveDictionary::currentFrequency(int symbol) const {
+  if (!table_ || symbol < table_->minSymbol() ||
+      symbol > table_->maxSymbol()) {
+    return 0;
+  }
+  return (*table_)[symbol].first;
+}
+
+}  // namespace rans
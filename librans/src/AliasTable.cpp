@@ -0,0 +1,101 @@
+/*
+ * AliasTable.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <stdexcept>
+
+#include "librans/AliasTable.h"
+
+namespace rans {
+
+AliasTable::AliasTable(const SymbolStatistics& stats, size_t probabilityBits)
+    : probabilityBits_(probabilityBits), bucketShift_(0), buckets_() {
+  // one bucket per symbol that can occur, rounded up to a power of two. Each
+  // symbol needs at least one slot, so this never exceeds the slots.
+  std::vector<int> symbols;
+  std::vector<uint32_t> weights;
+  int symbol = stats.minSymbol();
+  for (const auto& entry : stats) {
+    if (entry.first > 0) {
+      symbols.push_back(symbol);
+      weights.push_back(entry.first);
+    }
+    symbol++;
+  }
+  if (symbols.empty()) {
+    throw std::runtime_error("no symbols to build alias table from");
+  }
+
+  size_t bucketBits = 0;
+  while ((static_cast<size_t>(1) << bucketBits) < symbols.size()) {
+    bucketBits++;
+  }
+  bucketShift_ = probabilityBits - bucketBits;
+  const size_t numBuckets = static_cast<size_t>(1) << bucketBits;
+  const uint32_t bucketSize = 1u << bucketShift_;
+
+  // padding entries have weight 0 and are fully covered by their alias.
+  symbols.resize(numBuckets, stats.minSymbol());
+  weights.resize(numBuckets, 0);
+
+  // Vose's alias method: pair a bucket that is too small with one that is too
+  // large until every bucket holds exactly bucketSize slots. All weights are
+  // integers summing to numBuckets * bucketSize, so this is exact.
+  std::vector<size_t> alias(numBuckets);
+  std::vector<uint32_t> primary(weights);
+  std::vector<size_t> small;
+  std::vector<size_t> large;
+  for (size_t i = 0; i < numBuckets; i++) {
+    alias[i] = i;
+    if (weights[i] < bucketSize) {
+      small.push_back(i);
+    } else if (weights[i] > bucketSize) {
+      large.push_back(i);
+    }
+  }
+  while (!small.empty() && !large.empty()) {
+    const size_t s = small.back();
+    small.pop_back();
+    const size_t l = large.back();
+
+    alias[s] = l;
+    primary[s] = weights[s];
+    weights[l] -= bucketSize - weights[s];
+    if (weights[l] <= bucketSize) {
+      large.pop_back();
+      primary[l] = weights[l];
+      if (weights[l] < bucketSize) {
+        small.push_back(l);
+      }
+    }
+  }
+
+  // assign the slots of every symbol in increasing order, so the offset of a
+  // piece among the slots of its symbol never exceeds its first slot.
+  std::vector<uint32_t> assigned(numBuckets, 0);
+  buckets_.resize(numBuckets);
+  for (size_t i = 0; i < numBuckets; i++) {
+    const uint32_t bucketStart = i * bucketSize;
+    Bucket& bucket = buckets_[i];
+    bucket.divider = bucketStart + primary[i];
+
+    const size_t owners[2] = {i, alias[i]};
+    const uint32_t pieceStarts[2] = {bucketStart, bucket.divider};
+    const uint32_t pieceSizes[2] = {primary[i], bucketSize - primary[i]};
+    for (size_t j = 0; j < 2; j++) {
+      const size_t owner = owners[j];
+      bucket.symbol[j] = symbols[owner];
+      bucket.freq[j] = stats[symbols[owner]].first;
+      bucket.start[j] = pieceStarts[j] - assigned[owner];
+      assigned[owner] += pieceSizes[j];
+    }
+  }
+}
+
+size_t AliasTable::getProbabilityBits() const { return probabilityBits_; }
+
+size_t AliasTable::getNumBuckets() const { return buckets_.size(); }
+
+}  // namespace rans
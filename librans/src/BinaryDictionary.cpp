@@ -0,0 +1,313 @@
+/*
+ * BinaryDictionary.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "librans/BinaryDictionary.h"
+
+namespace rans {
+
+namespace {
+
+size_t align(size_t offset) {
+  const size_t alignment = BinaryDictionary::SECTION_ALIGNMENT;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+// MurmurHash64A, split up so a dictionary can be hashed with a patched copy
+// of its header in place of the real one.
+constexpr uint64_t MURMUR_M = 0xc6a4a7935bd1e995ull;
+constexpr int MURMUR_R = 47;
+
+uint64_t murmurInit(size_t size) {
+  return 0x8445d61a4e774912ull ^ (size * MURMUR_M);
+}
+
+// hashes the size / 8 whole blocks of data.
+uint64_t murmurBlocks(uint64_t h, const uint8_t* data, size_t size) {
+  const uint8_t* end = data + size / 8 * 8;
+  for (; data != end; data += 8) {
+    uint64_t k;
+    std::memcpy(&k, data, sizeof(k));
+    k *= MURMUR_M;
+    k ^= k >> MURMUR_R;
+    k *= MURMUR_M;
+    h ^= k;
+    h *= MURMUR_M;
+  }
+  return h;
+}
+
+// hashes the tail of up to 7 bytes behind the blocks and finalizes.
+uint64_t murmurFinish(uint64_t h, const uint8_t* data, size_t size) {
+  const uint8_t* tail = data + size / 8 * 8;
+  const size_t tailSize = size % 8;
+  if (tailSize > 0) {
+    for (size_t i = tailSize; i > 0; i--) {
+      h ^= static_cast<uint64_t>(tail[i - 1]) << (8 * (i - 1));
+    }
+    h *= MURMUR_M;
+  }
+  h ^= h >> MURMUR_R;
+  h *= MURMUR_M;
+  h ^= h >> MURMUR_R;
+  return h;
+}
+
+// Largest probabilityBits an encoder table for a state of coderBits can be
+// built for: the encoder symbols do not depend on the stream word, so the
+// widest interval of the coders of that state width counts. Narrower coders,
+// e.g. a 32 bit state with 16 bit words, are rejected by DictionaryEncoder
+// and DictionaryDecoder, which check Coder::maxScaleBits() like every Encoder
+// and Decoder.
+size_t maxProbabilityBits(size_t coderBits) {
+  switch (coderBits) {
+    case 0:
+      return 32;
+    case 32:
+      return Coder<uint32_t, uint8_t>::maxScaleBits();
+    case 64:
+      return Coder<uint64_t, uint32_t>::maxScaleBits();
+    default:
+      throw std::runtime_error("invalid coder bits for a dictionary");
+  }
+}
+}  // namespace
+
+void BinaryDictionary::checkStatistics(const SymbolStatistics& stats,
+                                       size_t probabilityBits,
+                                       size_t coderBits) {
+  std::vector<uint32_t> frequencies;
+  frequencies.reserve(stats.size());
+  for (const auto& entry : stats) {
+    frequencies.push_back(entry.first);
+  }
+  checkStatistics(frequencies.data(), frequencies.size(), probabilityBits,
+                  coderBits);
+}
+
+void BinaryDictionary::checkStatistics(const uint32_t* frequencies,
+                                       size_t numSymbols,
+                                       size_t probabilityBits,
+                                       size_t coderBits) {
+  if (probabilityBits > maxProbabilityBits(coderBits)) {
+    throw std::runtime_error("too many probability bits for a dictionary");
+  }
+  uint64_t cumulatedFrequency = 0;
+  for (size_t i = 0; i < numSymbols; i++) {
+    cumulatedFrequency += frequencies[i];
+  }
+  if (numSymbols == 0 ||
+      cumulatedFrequency != static_cast<uint64_t>(1) << probabilityBits) {
+    throw std::runtime_error(
+        "frequencies do not sum up to 1 << probabilityBits");
+  }
+}
+
+std::vector<uint8_t> BinaryDictionary::serialize(
+    const SymbolStatistics& stats, size_t probabilityBits,
+    bool withDecoderTable, size_t coderBits, const void* encoderTable,
+    size_t encoderSymbolBytes) {
+  BinaryDictionaryHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.version = VERSION;
+  header.probabilityBits = static_cast<uint8_t>(probabilityBits);
+  header.coderBits = coderBits;
+  header.min = stats.minSymbol();
+  header.numSymbols = stats.size();
+  header.encoderSymbolBytes = encoderSymbolBytes;
+
+  size_t size = align(sizeof(header));
+  header.frequenciesOffset = size;
+  size += stats.size() * sizeof(uint32_t);
+
+  std::optional<DecoderTable> decoderTable;
+  if (withDecoderTable) {
+    decoderTable.emplace(stats, probabilityBits);
+    header.decoderEntryBytes =
+        decoderTable->isPacked32() ? sizeof(uint32_t) : sizeof(uint64_t);
+    size = align(size);
+    header.decoderTableOffset = size;
+    size += decoderTable->getView().sizeBytes();
+  }
+
+  const size_t encoderTableBytes = encoderSymbolBytes * stats.size();
+  if (encoderTableBytes > 0) {
+    size = align(size);
+    header.encoderTableOffset = size;
+    size += encoderTableBytes;
+  }
+  size = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+  header.size = size;
+
+  std::vector<uint8_t> dictionary(size, 0);
+  uint32_t* frequencies = reinterpret_cast<uint32_t*>(
+      dictionary.data() + header.frequenciesOffset);
+  for (const auto& entry : stats) {
+    *frequencies++ = entry.first;
+  }
+  if (decoderTable) {
+    const DecoderTableView decoderView = decoderTable->getView();
+    std::memcpy(dictionary.data() + header.decoderTableOffset,
+                decoderView.data(), decoderView.sizeBytes());
+  }
+  if (header.encoderTableOffset) {
+    std::memcpy(dictionary.data() + header.encoderTableOffset, encoderTable,
+                encoderTableBytes);
+  }
+
+  std::memcpy(dictionary.data(), &header, sizeof(header));
+  header.checksum = dictionaryChecksum(dictionary.data(), size);
+  std::memcpy(dictionary.data(), &header, sizeof(header));
+  return dictionary;
+}
+
+bool BinaryDictionary::isBinaryDictionary(const void* data, size_t size) {
+  return size >= sizeof(MAGIC) &&
+         std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+// MurmurHash64A: eight bytes per step, which keeps verifying large tables
+// cheap compared to reading them from disk.
+uint64_t BinaryDictionary::checksum(const void* buffer, size_t size) {
+  const uint8_t* data = static_cast<const uint8_t*>(buffer);
+  return murmurFinish(murmurBlocks(murmurInit(size), data, size), data, size);
+}
+
+uint64_t BinaryDictionary::dictionaryChecksum(const void* buffer,
+                                              size_t size) {
+  const uint8_t* data = static_cast<const uint8_t*>(buffer);
+  BinaryDictionaryHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  header.checksum = 0;
+
+  // the header is a whole number of blocks, so hashing it apart from the
+  // rest gives the hash of the patched dictionary.
+  static_assert(sizeof(header) % 8 == 0, "header must be whole blocks");
+  uint64_t h = murmurBlocks(murmurInit(size),
+                            reinterpret_cast<const uint8_t*>(&header),
+                            sizeof(header));
+  const uint8_t* body = data + sizeof(header);
+  const size_t bodySize = size - sizeof(header);
+  return murmurFinish(murmurBlocks(h, body, bodySize), body, bodySize);
+}
+
+BinaryDictionaryView::BinaryDictionaryView(const void* data, size_t size,
+                                           bool verifyChecksum)
+    : data_(static_cast<const uint8_t*>(data)),
+      header_(static_cast<const BinaryDictionaryHeader*>(data)) {
+  if (!BinaryDictionary::isBinaryDictionary(data, size)) {
+    throw std::runtime_error("not a binary dictionary");
+  }
+  if (reinterpret_cast<uintptr_t>(data) % alignof(uint64_t)) {
+    throw std::runtime_error("binary dictionary is not aligned");
+  }
+  if (size < sizeof(BinaryDictionaryHeader)) {
+    throw std::runtime_error("corrupt dictionary: truncated");
+  }
+  if (header_->byteOrder != BinaryDictionary::BYTE_ORDER_MARK) {
+    throw std::runtime_error("dictionary was written with other byte order");
+  }
+  if (header_->version != BinaryDictionary::VERSION) {
+    throw std::runtime_error("unsupported dictionary version");
+  }
+  if (header_->size > size) {
+    throw std::runtime_error("corrupt dictionary: truncated");
+  }
+
+  // every section has to lie behind the header and inside the dictionary.
+  auto checkSection = [this](uint64_t offset, uint64_t bytes) {
+    if (offset % BinaryDictionary::SECTION_ALIGNMENT ||
+        offset < sizeof(BinaryDictionaryHeader) || offset > header_->size ||
+        bytes > header_->size - offset) {
+      throw std::runtime_error("corrupt dictionary: invalid section");
+    }
+  };
+  // the symbols min ... min + numSymbols - 1 have to be ints.
+  if (header_->probabilityBits > 32 || header_->numSymbols == 0 ||
+      static_cast<int64_t>(header_->min) + header_->numSymbols - 1 >
+          std::numeric_limits<int32_t>::max()) {
+    throw std::runtime_error("corrupt dictionary: invalid header");
+  }
+  checkSection(header_->frequenciesOffset,
+               static_cast<uint64_t>(header_->numSymbols) * sizeof(uint32_t));
+  if (header_->decoderTableOffset) {
+    if ((header_->decoderEntryBytes != sizeof(uint32_t) &&
+         header_->decoderEntryBytes != sizeof(uint64_t)) ||
+        !DecoderTable::canPack(header_->decoderEntryBytes,
+                               header_->numSymbols,
+                               header_->probabilityBits)) {
+      throw std::runtime_error("corrupt dictionary: invalid decoder table");
+    }
+    checkSection(header_->decoderTableOffset,
+                 header_->decoderEntryBytes *
+                     (static_cast<uint64_t>(1) << header_->probabilityBits));
+  }
+  if (header_->encoderTableOffset) {
+    checkSection(header_->encoderTableOffset,
+                 static_cast<uint64_t>(header_->encoderSymbolBytes) *
+                     header_->numSymbols);
+  }
+
+  if (verifyChecksum &&
+      BinaryDictionary::dictionaryChecksum(data_, header_->size) !=
+          header_->checksum) {
+    throw std::runtime_error("corrupt dictionary: checksum mismatch");
+  }
+
+  // the same checks serialize applies, so the tables handed out are usable.
+  try {
+    BinaryDictionary::checkStatistics(
+        getFrequencies(), header_->numSymbols, header_->probabilityBits,
+        header_->encoderTableOffset ? header_->coderBits : 0);
+  } catch (const std::runtime_error& error) {
+    throw std::runtime_error(std::string("corrupt dictionary: ") +
+                             error.what());
+  }
+}
+
+const BinaryDictionaryHeader& BinaryDictionaryView::getHeader() const {
+  return *header_;
+}
+
+size_t BinaryDictionaryView::getProbabilityBits() const {
+  return header_->probabilityBits;
+}
+
+int BinaryDictionaryView::getMinSymbol() const { return header_->min; }
+
+size_t BinaryDictionaryView::size() const { return header_->numSymbols; }
+
+const uint32_t* BinaryDictionaryView::getFrequencies() const {
+  return reinterpret_cast<const uint32_t*>(data_ +
+                                           header_->frequenciesOffset);
+}
+
+SymbolStatistics BinaryDictionaryView::getSymbolStatistics() const {
+  return SymbolStatistics(
+      header_->min,
+      std::vector<uint32_t>(getFrequencies(), getFrequencies() + size()));
+}
+
+bool BinaryDictionaryView::hasDecoderTable() const {
+  return header_->decoderTableOffset != 0;
+}
+
+DecoderTableView BinaryDictionaryView::getDecoderTable() const {
+  if (!hasDecoderTable()) {
+    throw std::runtime_error("dictionary has no decoder table");
+  }
+  return DecoderTableView(data_ + header_->decoderTableOffset,
+                          header_->decoderEntryBytes == sizeof(uint32_t),
+                          header_->probabilityBits, header_->min);
+}
+
+}  // namespace rans
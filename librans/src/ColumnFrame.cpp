@@ -0,0 +1,119 @@
+/*
+ * ColumnFrame.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <cstring>
+#include <limits>
+
+#include "librans/ByteIO.h"
+#include "librans/ColumnFrame.h"
+#include "librans/Frame.h"
+
+namespace rans {
+
+namespace {
+
+constexpr char MAGIC[] = {'r', 'A', 'N', 'C'};
+constexpr size_t PAYLOAD_ALIGNMENT = 8;
+
+size_t paddingBytes(size_t offset) {
+  return (PAYLOAD_ALIGNMENT - offset % PAYLOAD_ALIGNMENT) % PAYLOAD_ALIGNMENT;
+}
+}  // namespace
+
+ColumnFrame::ColumnFrame(const uint8_t* data, size_t size) {
+  ByteReader reader(data, size);
+
+  reader.require(sizeof(MAGIC));
+  if (std::memcmp(reader.position(), MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("not a rANS column frame");
+  }
+  reader.skip(sizeof(MAGIC));
+
+  if (reader.get<uint16_t>() != VERSION) {
+    throw std::runtime_error("unsupported frame version");
+  }
+  coderBits_ = reader.get<uint8_t>();
+  streamBytes_ = reader.get<uint8_t>();
+  numLanes_ = reader.get<uint16_t>();
+  if (streamBytes_ == 0) {
+    throw std::runtime_error("corrupt frame: invalid stream word size");
+  }
+  const uint64_t numColumns = reader.getVarint();
+  // every column takes at least 27 bytes.
+  if (numColumns > reader.remaining() / 27) {
+    throw std::runtime_error("corrupt frame: truncated");
+  }
+
+  uint64_t payloadWords = 0;
+  columns_.reserve(numColumns);
+  for (uint64_t column = 0; column < numColumns; column++) {
+    const uint8_t probabilityBits = reader.get<uint8_t>();
+    const uint8_t sourceBytes = reader.get<uint8_t>();
+    if (probabilityBits > 32) {
+      throw std::runtime_error("corrupt frame: invalid probability bits");
+    }
+    SymbolStatistics stats =
+        readDictionary(reader, probabilityBits, sourceBytes);
+    BlockIndexEntry entry;
+    entry.offset = reader.get<uint64_t>();
+    entry.size = reader.get<uint64_t>();
+    entry.numSymbols = reader.get<uint64_t>();
+    if (entry.offset != payloadWords ||
+        entry.size > std::numeric_limits<uint64_t>::max() - payloadWords) {
+      throw std::runtime_error("corrupt frame: invalid column index");
+    }
+    payloadWords += entry.size;
+    columns_.push_back({probabilityBits, sourceBytes, std::move(stats), entry});
+  }
+
+  reader.skip(paddingBytes(reader.position() - data));
+  if (payloadWords > reader.remaining() / streamBytes_) {
+    throw std::runtime_error("corrupt frame: truncated");
+  }
+  payload_ = reader.position();
+}
+
+std::vector<uint8_t> ColumnFrame::serialize(
+    uint8_t coderBits, uint8_t streamBytes, uint16_t numLanes,
+    const std::vector<ColumnInfo>& columns, const uint8_t* sourceBytes,
+    const std::vector<BlockIndexEntry>& entries, size_t payloadBytes) {
+  if (entries.size() != columns.size()) {
+    throw std::runtime_error("number of entries does not match columns");
+  }
+  std::vector<uint8_t> frame(MAGIC, MAGIC + sizeof(MAGIC));
+  ByteWriter writer(frame);
+
+  writer.put(VERSION);
+  writer.put(coderBits);
+  writer.put(streamBytes);
+  writer.put(numLanes);
+  writer.putVarint(columns.size());
+  for (size_t column = 0; column < columns.size(); column++) {
+    const BlockIndexEntry& entry = entries[column];
+    writer.put(columns[column].probabilityBits);
+    writer.put(sourceBytes[column]);
+    writeDictionary(writer, columns[column].stats);
+    writer.put(entry.offset);
+    writer.put(entry.size);
+    writer.put(entry.numSymbols);
+  }
+
+  frame.resize(frame.size() + paddingBytes(frame.size()) + payloadBytes, 0);
+  return frame;
+}
+
+size_t ColumnFrame::getPayloadSize(
+    const std::vector<BlockIndexEntry>& entries) {
+  return entries.empty() ? 0 : entries.back().offset + entries.back().size;
+}
+
+size_t ColumnFrame::getNumColumns() const { return columns_.size(); }
+
+const ColumnInfo& ColumnFrame::getColumn(size_t column) const {
+  return columns_.at(column);
+}
+
+}  // namespace rans
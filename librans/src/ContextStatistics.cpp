@@ -0,0 +1,271 @@
+/*
+ * ContextStatistics.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "librans/ByteIO.h"
+#include "librans/ContextStatistics.h"
+
+namespace rans {
+
+namespace {
+
+size_t contextShiftFor(size_t range) {
+  size_t bits = 0;
+  while ((static_cast<size_t>(1) << bits) < range) {
+    bits++;
+  }
+  return bits > ContextStatistics::MAX_CONTEXT_BITS
+             ? bits - ContextStatistics::MAX_CONTEXT_BITS
+             : 0;
+}
+
+// Normalized table over the nonzero counts[first, last) of the symbols
+// min + first, ...
+SymbolStatistics normalizedTable(int min, const std::vector<uint32_t>& counts,
+                                 size_t probabilityBits) {
+  const auto isSet = [](uint32_t count) { return count > 0; };
+  const auto first = std::find_if(counts.begin(), counts.end(), isSet);
+  const auto last = std::find_if(counts.rbegin(), counts.rend(), isSet).base();
+  SymbolStatistics table(min + static_cast<int>(first - counts.begin()),
+                         std::vector<uint32_t>(first, last));
+  table.rescaleFrequencyTable(static_cast<uint32_t>(1) << probabilityBits);
+  return table;
+}
+
+}  // namespace
+
+void ContextStatistics::build(const std::vector<uint32_t>& symbols,
+                              size_t maxTables) {
+  if (maxTables == 0) {
+    throw std::runtime_error("context model needs a fallback table");
+  }
+  const size_t range = static_cast<int64_t>(max_) - min_ + 1;
+  contextShift_ = contextShiftFor(range);
+  const size_t numContexts = ((range - 1) >> contextShift_) + 1;
+  auto contextOf = [&](size_t i) {
+    return i == 0 ? 0 : symbols[i - 1] >> contextShift_;
+  };
+
+  // group the symbols by context with a counting sort.
+  std::vector<uint64_t> offsets(numContexts + 1, 0);
+  for (size_t i = 0; i < symbols.size(); i++) {
+    offsets[contextOf(i) + 1]++;
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<uint32_t> successors(symbols.size());
+  {
+    std::vector<uint64_t> positions(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < symbols.size(); i++) {
+      successors[positions[contextOf(i)]++] = symbols[i];
+    }
+  }
+  auto forEachSuccessor = [&](size_t context, auto&& f) {
+    for (uint64_t i = offsets[context]; i < offsets[context + 1]; i++) {
+      f(successors[i]);
+    }
+  };
+
+  const std::vector<uint32_t> order0 = histogram(
+      symbols.data(), symbols.data() + symbols.size(), 0, range);
+
+  // a context gets a table of its own if the bits it saves over the order-0
+  // distribution exceed an estimate of the bits of the table itself.
+  struct Candidate {
+    size_t context;
+    double saving;
+    uint64_t count;
+    size_t span;  // symbols between the first and last successor
+  };
+  std::vector<Candidate> candidates;
+  std::vector<uint32_t> counts(range, 0);
+  std::vector<uint32_t> seen;
+  for (size_t context = 0; context < numContexts; context++) {
+    const uint64_t count = offsets[context + 1] - offsets[context];
+    if (count == 0) {
+      continue;
+    }
+    forEachSuccessor(context, [&](uint32_t symbol) {
+      if (counts[symbol]++ == 0) {
+        seen.push_back(symbol);
+      }
+    });
+    const auto bounds = std::minmax_element(seen.begin(), seen.end());
+    const size_t span = *bounds.second - *bounds.first + 1;
+    double saving = 0;
+    for (const uint32_t symbol : seen) {
+      const double n = counts[symbol];
+      saving += n * (std::log2(n / count) -
+                     std::log2(static_cast<double>(order0[symbol]) /
+                               symbols.size()));
+      counts[symbol] = 0;
+    }
+    const double tableBits = 8.0 * (4 + 2 * seen.size());
+    if (saving > tableBits) {
+      candidates.push_back({context, saving - tableBits, count, span});
+    }
+    seen.clear();
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              return a.saving > b.saving;
+            });
+  // the best candidates whose tables fit next to the fallback table.
+  size_t budget = MAX_MODEL_SIZE - range;
+  size_t numSelected = 0;
+  for (const auto& candidate : candidates) {
+    if (numSelected == maxTables - 1) {
+      break;
+    }
+    if (candidate.span <= budget) {
+      budget -= candidate.span;
+      candidates[numSelected++] = candidate;
+    }
+  }
+  candidates.resize(numSelected);
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              return a.count > b.count;
+            });
+
+  tableIndices_.assign(numContexts, 0);
+  tables_.clear();
+  tables_.reserve(candidates.size() + 1);
+  tables_.emplace_back(0, std::vector<uint32_t>{0});  // fallback, see below
+  for (const auto& candidate : candidates) {
+    tableIndices_[candidate.context] = tables_.size();
+    forEachSuccessor(candidate.context,
+                     [&](uint32_t symbol) { counts[symbol]++; });
+    tables_.push_back(normalizedTable(min_, counts, probabilityBits_));
+    std::fill(counts.begin(), counts.end(), 0);
+  }
+
+  // the fallback table covers the contexts without a table, or everything if
+  // there are none.
+  for (size_t context = 0; context < numContexts; context++) {
+    if (tableIndices_[context] == 0) {
+      forEachSuccessor(context, [&](uint32_t symbol) { counts[symbol]++; });
+    }
+  }
+  if (std::all_of(counts.begin(), counts.end(),
+                  [](uint32_t count) { return count == 0; })) {
+    counts = order0;
+  }
+  tables_.front() = normalizedTable(min_, counts, probabilityBits_);
+}
+
+ContextStatistics::ContextStatistics(const uint8_t* data, size_t size) {
+  ByteReader reader(data, size);
+  probabilityBits_ = reader.getVarint();
+  const int64_t min = reader.getZigZag();
+  const int64_t max = reader.getZigZag();
+  if (probabilityBits_ > 31 || min > max ||
+      min < std::numeric_limits<int>::min() ||
+      max > std::numeric_limits<int>::max() ||
+      max - min >= static_cast<int64_t>(MAX_SYMBOL_RANGE)) {
+    throw std::runtime_error("corrupt context model: invalid header");
+  }
+  min_ = min;
+  max_ = max;
+  const size_t range = max - min + 1;
+  contextShift_ = reader.getVarint();
+  if (contextShift_ != contextShiftFor(range)) {
+    throw std::runtime_error("corrupt context model: invalid header");
+  }
+  const size_t numContexts = getNumContexts();
+
+  const uint64_t numTables = reader.getVarint();
+  if (numTables == 0 || numTables > numContexts + 1) {
+    throw std::runtime_error("corrupt context model: invalid header");
+  }
+  // tables are dense, so a few bytes can declare a table over the whole
+  // symbol range; their total size is bounded like the tables built.
+  size_t budget = MAX_MODEL_SIZE;
+  for (uint64_t table = 0; table < numTables; table++) {
+    const uint64_t offset = reader.getVarint();
+    const uint64_t numFrequencies = reader.getVarint();
+    if (numFrequencies == 0 || offset >= range ||
+        numFrequencies > range - offset) {
+      throw std::runtime_error("corrupt context model: invalid table");
+    }
+    if (numFrequencies > budget) {
+      throw std::runtime_error("corrupt context model: tables too large");
+    }
+    budget -= numFrequencies;
+    std::vector<uint32_t> frequencies =
+        reader.getRunLengthVarints<uint32_t>(numFrequencies);
+    uint64_t cumulatedFrequency = 0;
+    for (const uint32_t frequency : frequencies) {
+      cumulatedFrequency += frequency;
+    }
+    if (cumulatedFrequency != static_cast<uint64_t>(1) << probabilityBits_) {
+      throw std::runtime_error("corrupt context model: invalid table");
+    }
+    tables_.emplace_back(min_ + static_cast<int>(offset),
+                         std::move(frequencies));
+  }
+
+  const std::vector<uint64_t> indices =
+      reader.getRunLengthVarints(numContexts);
+  for (const uint64_t index : indices) {
+    if (index >= numTables) {
+      throw std::runtime_error("corrupt context model: invalid table index");
+    }
+  }
+  tableIndices_.assign(indices.begin(), indices.end());
+  if (reader.remaining() != 0) {
+    throw std::runtime_error("corrupt context model: trailing bytes");
+  }
+}
+
+std::vector<uint8_t> ContextStatistics::serialize() const {
+  std::vector<uint8_t> buffer;
+  ByteWriter writer(buffer);
+  writer.putVarint(probabilityBits_);
+  writer.putZigZag(min_);
+  writer.putZigZag(max_);
+  writer.putVarint(contextShift_);
+  writer.putVarint(tables_.size());
+  for (const auto& table : tables_) {
+    writer.putVarint(static_cast<int64_t>(table.minSymbol()) - min_);
+    writer.putVarint(table.size());
+    std::vector<uint64_t> frequencies;
+    frequencies.reserve(table.size());
+    for (const auto& entry : table) {
+      frequencies.push_back(entry.first);
+    }
+    writer.putRunLengthVarints(frequencies);
+  }
+  writer.putRunLengthVarints(
+      std::vector<uint64_t>(tableIndices_.begin(), tableIndices_.end()));
+  return buffer;
+}
+
+size_t ContextStatistics::getProbabilityBits() const {
+  return probabilityBits_;
+}
+
+int ContextStatistics::minSymbol() const { return min_; }
+
+int ContextStatistics::maxSymbol() const { return max_; }
+
+size_t ContextStatistics::getContextShift() const { return contextShift_; }
+
+size_t ContextStatistics::getNumContexts() const {
+  return ((static_cast<int64_t>(max_) - min_) >> contextShift_) + 1;
+}
+
+size_t ContextStatistics::getNumTables() const { return tables_.size(); }
+
+const SymbolStatistics& ContextStatistics::getTable(size_t index) const {
+  return tables_[index];
+}
+
+}  // namespace rans
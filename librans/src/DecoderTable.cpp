@@ -0,0 +1,82 @@
+/*
+ * DecoderTable.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "librans/DecoderTable.h"
+
+namespace rans {
+
+namespace {
+size_t bitsFor(size_t size) {
+  size_t bits = 0;
+  while ((static_cast<size_t>(1) << bits) < size) {
+    bits++;
+  }
+  return bits;
+}
+}  // namespace
+
+DecoderTable::DecoderTable(const SymbolStatistics& stats,
+                           size_t probabilityBits)
+    : probabilityBits_(probabilityBits), min_(stats.minSymbol()) {
+  if (canPack(sizeof(uint32_t), stats.size(), probabilityBits)) {
+    packed32_ = build<uint32_t>(stats, probabilityBits);
+  } else if (canPack(sizeof(uint64_t), stats.size(), probabilityBits)) {
+    packed64_ = build<uint64_t>(stats, probabilityBits);
+  } else {
+    throw std::runtime_error("symbol range too large for decoder table");
+  }
+}
+
+bool DecoderTable::canPack(size_t entryBytes, size_t numSymbols,
+                           size_t probabilityBits) {
+  // the symbol shift has to stay below the width of the entry.
+  const size_t entryBits = 8 * entryBytes;
+  const size_t symbolShift = 2 * probabilityBits;
+  return symbolShift < entryBits &&
+         symbolShift + bitsFor(numSymbols) <= entryBits;
+}
+
+template <typename packed_T>
+std::vector<packed_T> DecoderTable::build(const SymbolStatistics& stats,
+                                          size_t probabilityBits) {
+  std::vector<packed_T> table(static_cast<size_t>(1) << probabilityBits);
+
+  // every slot is written exactly once: linear in the table size.
+  packed_T index = 0;
+  for (const auto& entry : stats) {
+    const uint32_t freq = entry.first;
+    const uint32_t start = entry.second;
+    if (freq > 0) {
+      const packed_T packed = (index << (2 * probabilityBits)) |
+                              (static_cast<packed_T>(start) << probabilityBits) |
+                              (freq - 1);
+      std::fill(table.begin() + start, table.begin() + start + freq, packed);
+    }
+    index++;
+  }
+  return table;
+}
+
+bool DecoderTable::isPacked32() const { return !packed32_.empty(); }
+
+size_t DecoderTable::getProbabilityBits() const { return probabilityBits_; }
+
+DecoderTableEntry DecoderTable::operator[](uint32_t slot) const {
+  return getView()[slot];
+}
+
+DecoderTableView DecoderTable::getView() const {
+  if (isPacked32()) {
+    return DecoderTableView(packed32_.data(), true, probabilityBits_, min_);
+  } else {
+    return DecoderTableView(packed64_.data(), false, probabilityBits_, min_);
+  }
+}
+
+}  // namespace rans
@@ -0,0 +1,182 @@
+/*
+ * Frame.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <cstring>
+#include <limits>
+
+#include "librans/ByteIO.h"
+#include "librans/Frame.h"
+
+namespace rans {
+
+namespace {
+
+constexpr char MAGIC[] = {'r', 'A', 'N', 'S'};
+constexpr size_t PAYLOAD_ALIGNMENT = 8;
+
+size_t paddingBytes(size_t offset) {
+  return (PAYLOAD_ALIGNMENT - offset % PAYLOAD_ALIGNMENT) % PAYLOAD_ALIGNMENT;
+}
+}  // namespace
+
+void writeDictionary(ByteWriter& writer, const SymbolStatistics& stats) {
+  if (stats.size() > MAX_DICTIONARY_SIZE) {
+    throw std::runtime_error("dictionary too large");
+  }
+  std::vector<uint8_t> dictionary;
+  ByteWriter dictionaryWriter(dictionary);
+  dictionaryWriter.putZigZag(stats.minSymbol());
+  dictionaryWriter.putVarint(stats.size());
+  std::vector<uint64_t> frequencies;
+  frequencies.reserve(stats.size());
+  for (const auto& entry : stats) {
+    frequencies.push_back(entry.first);
+  }
+  dictionaryWriter.putRunLengthVarints(frequencies);
+  writer.putVarint(dictionary.size());
+  for (const uint8_t byte : dictionary) {
+    writer.put(byte);
+  }
+}
+
+SymbolStatistics readDictionary(ByteReader& reader, size_t probabilityBits,
+                                size_t sourceBytes) {
+  const uint64_t dictionaryBytes = reader.getVarint();
+  reader.require(dictionaryBytes);
+  const uint8_t* dictionaryEnd = reader.position() + dictionaryBytes;
+  const int64_t min = reader.getZigZag();
+  const uint64_t numFrequencies = reader.getVarint();
+  if (numFrequencies > MAX_DICTIONARY_SIZE ||
+      min < std::numeric_limits<int>::min() ||
+      min + static_cast<int64_t>(numFrequencies) - 1 >
+          std::numeric_limits<int>::max()) {
+    throw std::runtime_error("corrupt data: invalid dictionary");
+  }
+  // symbols of sources narrower than an int are in [0, 2^(8 * sourceBytes)).
+  if (sourceBytes < sizeof(int) &&
+      (min < 0 || min + static_cast<int64_t>(numFrequencies) - 1 >=
+                      int64_t(1) << (8 * sourceBytes))) {
+    throw std::runtime_error("corrupt data: invalid dictionary");
+  }
+  std::vector<uint32_t> frequencies =
+      reader.getRunLengthVarints<uint32_t>(numFrequencies);
+  uint64_t cumulatedFrequency = 0;
+  for (const uint32_t frequency : frequencies) {
+    cumulatedFrequency += frequency;
+  }
+  if (reader.position() != dictionaryEnd ||
+      cumulatedFrequency != (1ull << probabilityBits)) {
+    throw std::runtime_error("corrupt data: invalid dictionary");
+  }
+  return SymbolStatistics(static_cast<int>(min), std::move(frequencies));
+}
+
+Frame::Frame(const uint8_t* data, size_t size) {
+  ByteReader reader(data, size);
+
+  reader.require(sizeof(MAGIC));
+  if (std::memcmp(reader.position(), MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("not a rANS frame");
+  }
+  reader.skip(sizeof(MAGIC));
+
+  header_.version = reader.get<uint16_t>();
+  if (header_.version != VERSION) {
+    throw std::runtime_error("unsupported frame version");
+  }
+  header_.coderBits = reader.get<uint8_t>();
+  header_.streamBytes = reader.get<uint8_t>();
+  header_.probabilityBits = reader.get<uint8_t>();
+  header_.sourceBytes = reader.get<uint8_t>();
+  if (header_.probabilityBits > 32) {
+    throw std::runtime_error("corrupt frame: invalid probability bits");
+  }
+  if (header_.streamBytes == 0) {
+    throw std::runtime_error("corrupt frame: invalid stream word size");
+  }
+  header_.numLanes = reader.get<uint16_t>();
+  header_.numSymbols = reader.get<uint64_t>();
+  header_.numBlocks = reader.get<uint64_t>();
+
+  stats_ = std::make_unique<SymbolStatistics>(
+      readDictionary(reader, header_.probabilityBits, header_.sourceBytes));
+
+  // block index
+  if (header_.numBlocks > reader.remaining() / (3 * sizeof(uint64_t))) {
+    throw std::runtime_error("corrupt frame: truncated");
+  }
+  index_.resize(header_.numBlocks);
+  uint64_t numSymbols = 0;
+  uint64_t payloadWords = 0;
+  for (auto& entry : index_) {
+    entry.offset = reader.get<uint64_t>();
+    entry.size = reader.get<uint64_t>();
+    entry.numSymbols = reader.get<uint64_t>();
+    if (entry.offset != payloadWords ||
+        entry.size > std::numeric_limits<uint64_t>::max() - payloadWords ||
+        entry.numSymbols >
+            std::numeric_limits<uint64_t>::max() - numSymbols) {
+      throw std::runtime_error("corrupt frame: invalid block index");
+    }
+    payloadWords += entry.size;
+    numSymbols += entry.numSymbols;
+  }
+  if (numSymbols != header_.numSymbols) {
+    throw std::runtime_error("corrupt frame: symbol count mismatch");
+  }
+
+  // payload
+  reader.skip(paddingBytes(reader.position() - data));
+  if (payloadWords > reader.remaining() / header_.streamBytes) {
+    throw std::runtime_error("corrupt frame: truncated");
+  }
+  payloadBytes_ = payloadWords * header_.streamBytes;
+  payload_ = reader.position();
+}
+
+std::vector<uint8_t> Frame::serialize(const FrameHeader& header,
+                                      const SymbolStatistics& stats,
+                                      const std::vector<BlockIndexEntry>& index,
+                                      const void* payload,
+                                      size_t payloadBytes) {
+  std::vector<uint8_t> frame(MAGIC, MAGIC + sizeof(MAGIC));
+  ByteWriter writer(frame);
+
+  writer.put(header.version);
+  writer.put(header.coderBits);
+  writer.put(header.streamBytes);
+  writer.put(header.probabilityBits);
+  writer.put(header.sourceBytes);
+  writer.put(header.numLanes);
+  writer.put(header.numSymbols);
+  writer.put(header.numBlocks);
+
+  writeDictionary(writer, stats);
+
+  for (const auto& entry : index) {
+    writer.put(entry.offset);
+    writer.put(entry.size);
+    writer.put(entry.numSymbols);
+  }
+
+  frame.resize(frame.size() + paddingBytes(frame.size()), 0);
+  const size_t payloadOffset = frame.size();
+  frame.resize(payloadOffset + payloadBytes);
+  if (payloadBytes > 0) {
+    std::memcpy(frame.data() + payloadOffset, payload, payloadBytes);
+  }
+  return frame;
+}
+
+const FrameHeader& Frame::getHeader() const { return header_; }
+
+const SymbolStatistics& Frame::getSymbolStatistics() const { return *stats_; }
+
+const std::vector<BlockIndexEntry>& Frame::getBlockIndex() const {
+  return index_;
+}
+
+}  // namespace rans
@@ -0,0 +1,93 @@
+/*
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "librans/MappedFile.h"
+
+namespace rans {
+
+namespace {
+
+// transparent huge pages only pay off for mappings spanning several of them.
+constexpr size_t HUGE_PAGE_THRESHOLD = 1 << 23;
+
+std::runtime_error systemError(const std::string& what,
+                               const std::string& path) {
+  return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw systemError("cannot open", path);
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0) {
+    const auto error = systemError("cannot stat", path);
+    ::close(fd);
+    throw error;
+  }
+  size_ = status.st_size;
+  if (size_ == 0) {
+    // an empty file can not be mapped.
+    ::close(fd);
+    return;
+  }
+
+  void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping keeps the file alive.
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw systemError("cannot map", path);
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+
+  // hints only, failures are harmless.
+  ::madvise(mapping, size_, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+  if (size_ >= HUGE_PAGE_THRESHOLD) {
+    ::madvise(mapping, size_, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+const uint8_t* MappedFile::data() const { return data_; }
+
+size_t MappedFile::size() const { return size_; }
+
+void MappedFile::unmap() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+    data_ = nullptr;
+  }
+}
+
+}  // namespace rans
@@ -0,0 +1,78 @@
+/*
+ * SIMDLevel.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "librans/SIMDLevel.h"
+
+#include <stdexcept>
+
+namespace rans {
+
+namespace {
+
+SIMDLevel queryCpu() {
+#ifdef RANS_X86
+  // __builtin_cpu_supports also checks that the OS saves the vector registers.
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+      __builtin_cpu_supports("avx512bw")) {
+    return SIMDLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMDLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return SIMDLevel::SSE41;
+  }
+#endif
+  return SIMDLevel::Scalar;
+}
+
+}  // namespace
+
+SIMDLevel detectSIMDLevel() {
+  static const SIMDLevel level = queryCpu();
+  return level;
+}
+
+bool isSupported(SIMDLevel level) { return level <= detectSIMDLevel(); }
+
+std::vector<SIMDLevel> supportedSIMDLevels() {
+  std::vector<SIMDLevel> levels;
+  for (const SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SSE41,
+                                SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+    if (isSupported(level)) {
+      levels.push_back(level);
+    }
+  }
+  return levels;
+}
+
+std::string toString(SIMDLevel level) {
+  switch (level) {
+    case SIMDLevel::Scalar:
+      return "Scalar";
+    case SIMDLevel::SSE41:
+      return "SSE4.1";
+    case SIMDLevel::AVX2:
+      return "AVX2";
+    case SIMDLevel::AVX512:
+      return "AVX512";
+    default:
+      throw std::runtime_error("unknown SIMDLevel");
+  }
+}
+
+SIMDLevel simdLevelFromString(const std::string& name) {
+  for (const SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SSE41,
+                                SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+    if (toString(level) == name) {
+      return level;
+    }
+  }
+  throw std::runtime_error("unknown SIMDLevel " + name);
+}
+
+}  // namespace rans
@@ -0,0 +1,67 @@
+/*
+ * SparseSymbolStatistics.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "librans/SparseSymbolStatistics.h"
+
+namespace rans {
+
+void SparseSymbolStatistics::build(
+    std::vector<std::pair<int64_t, uint64_t>> counts, size_t maxSymbols) {
+  if (counts.empty()) {
+    throw std::runtime_error("no tokens to build statistics from");
+  }
+
+  // the most frequent values first, ties broken by value to stay
+  // deterministic.
+  const size_t numSymbols = std::min(maxSymbols, counts.size());
+  const auto moreFrequent = [](const auto& a, const auto& b) {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  };
+  std::nth_element(counts.begin(), counts.begin() + numSymbols, counts.end(),
+                   moreFrequent);
+  const auto byValue = [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  };
+  std::sort(counts.begin(), counts.begin() + numSymbols, byValue);
+
+  std::vector<uint32_t> frequencies;
+  frequencies.reserve(numSymbols + 1);
+  values_.reserve(numSymbols);
+  indices_.reserve(numSymbols);
+  for (size_t i = 0; i < numSymbols; i++) {
+    values_.push_back(counts[i].first);
+    indices_.emplace(counts[i].first, i);
+    frequencies.push_back(counts[i].second);
+  }
+
+  // everything else is escaped. The escape keeps a nonzero frequency even if
+  // there is nothing else, so values that were not seen can be coded too.
+  uint64_t escapes = 0;
+  for (auto it = counts.begin() + numSymbols; it != counts.end(); ++it) {
+    escapes += it->second;
+  }
+  frequencies.push_back(std::max<uint64_t>(escapes, 1));
+
+  indexStatistics_ = SymbolStatistics(0, std::move(frequencies));
+}
+
+void SparseSymbolStatistics::rescaleFrequencyTable(
+    uint32_t newCumulatedFrequency) {
+  indexStatistics_.rescaleFrequencyTable(newCumulatedFrequency);
+}
+
+const SymbolStatistics& SparseSymbolStatistics::getIndexStatistics() const {
+  return indexStatistics_;
+}
+
+uint32_t SparseSymbolStatistics::getEscapeIndex() const {
+  return values_.size();
+}
+
+}  // namespace rans
@@ -1,5 +1,8 @@
 
 #include <cmath>
+#include <functional>
+#include <queue>
+#include <tuple>
 
 #include "librans/SymbolStatistics.h"
 namespace rans {
@@ -24,6 +27,17 @@ SymbolStatistics::SymbolStatistics(const json::Value& document) {
   buildCumulativeFrequencyTable();
 }
 
+SymbolStatistics::SymbolStatistics(int min, std::vector<uint32_t> frequencies)
+    : min_(min),
+      max_(min + static_cast<int>(frequencies.size()) - 1),
+      frequencyTable_(std::move(frequencies)),
+      cumulativeFrequencyTable_() {
+  if (frequencyTable_.empty()) {
+    throw std::runtime_error("empty frequency table");
+  }
+  buildCumulativeFrequencyTable();
+}
+
 json::Value SymbolStatistics::serialize(
     json::Document::AllocatorType& allocator) const {
   const std::string test = "test";
@@ -43,79 +57,102 @@ json::Value SymbolStatistics::serialize(
 }
 
 void SymbolStatistics::rescaleFrequencyTable(uint32_t newCumulatedFrequency) {
-  assert(newCumulatedFrequency >= frequencyTable_.size());
-
-  //	std:: cout << "min: " <<min_ << " max: " << max_ << std::endl;
-  //	    for(int i = 0; i<static_cast<int>(freqs.size()); i++){
-  //	    	std::cout << i << ": " << i + min << " " << freqs[i] << " " <<
-  // cum_freqs[i] << std::endl;
-  //	    }
-  //	    std::cout <<  cummulatedFrequencies_.back() << std::endl;
-
-  size_t cumulatedFrequencies = cumulativeFrequencyTable_.back();
-
-  //	    assert(target_total >= cur_total);
-
-  // resample distribution based on cumulative frequencies_
-  for (size_t i = 1; i <= frequencyTable_.size(); i++)
-    cumulativeFrequencyTable_[i] =
-        (static_cast<uint64_t>(newCumulatedFrequency) *
-         cumulativeFrequencyTable_[i]) /
-        cumulatedFrequencies;
-
-  // if we nuked any non-0 frequency symbol to 0, we need to steal
-  // the range to make the frequency nonzero from elsewhere.
-  //
-  // this is not at all optimal, i'm just doing the first thing that comes to
-  // mind.
-  for (size_t i = 0; i < frequencyTable_.size(); i++) {
-    if (frequencyTable_[i] &&
-        cumulativeFrequencyTable_[i + 1] == cumulativeFrequencyTable_[i]) {
-      // symbol i was set to zero freq
-
-      // find best symbol to steal frequency from (try to steal from low-freq
-      // ones)
-      std::pair<size_t, size_t> stealFromEntry{frequencyTable_.size(), ~0u};
-      for (size_t j = 0; j < frequencyTable_.size(); j++) {
-        uint32_t frequency =
-            cumulativeFrequencyTable_[j + 1] - cumulativeFrequencyTable_[j];
-        if (frequency > 1 && frequency < stealFromEntry.second) {
-          stealFromEntry.second = frequency;
-          stealFromEntry.first = j;
-        }
-      }
-      assert(stealFromEntry.first != frequencyTable_.size());
-
-      // and steal from it!
-      if (stealFromEntry.first < i) {
-        for (size_t j = stealFromEntry.first + 1; j <= i; j++)
-          cumulativeFrequencyTable_[j]--;
-      } else {
-        assert(stealFromEntry.first > i);
-        for (size_t j = i + 1; j <= stealFromEntry.first; j++)
-          cumulativeFrequencyTable_[j]++;
-      }
+  // Finds the table with the lowest coding cost
+  //   -sum_i count_i * log2(frequency_i / newCumulatedFrequency)
+  // among all tables that sum to newCumulatedFrequency and keep exactly the
+  // symbols seen so far. The cost is separable and convex in every frequency,
+  // so a table is optimal as soon as moving a single unit of frequency from
+  // one symbol to another cannot lower it any more. Starting from the rounded
+  // down scaled counts only a few such moves are left, each one is picked from
+  // a heap in O(log n).
+  const uint64_t cumulatedFrequencies = cumulativeFrequencyTable_.back();
+  if (cumulatedFrequencies == 0) {
+    throw std::runtime_error("cannot rescale an empty frequency table");
+  }
+  const size_t numSymbols =
+      frequencyTable_.size() -
+      std::count(frequencyTable_.begin(), frequencyTable_.end(), 0);
+  if (numSymbols > newCumulatedFrequency) {
+    throw std::runtime_error("too many symbols for cumulated frequency");
+  }
+
+  std::vector<uint32_t> counts(frequencyTable_);
+  uint64_t newFrequencies = 0;
+  for (auto& frequency : frequencyTable_) {
+    if (frequency > 0) {
+      frequency = std::max<uint64_t>(
+          1, static_cast<uint64_t>(newCumulatedFrequency) * frequency /
+                 cumulatedFrequencies);
+      newFrequencies += frequency;
     }
   }
 
-  // calculate updated freqs and make sure we didn't screw anything up
-  assert(cumulativeFrequencyTable_.front() == 0 &&
-         cumulativeFrequencyTable_.back() == newCumulatedFrequency);
+  // coding cost saved by giving symbol i one more unit of frequency and lost
+  // by taking one away.
+  auto gain = [&](size_t i) {
+    return counts[i] * std::log2(1.0 + 1.0 / frequencyTable_[i]);
+  };
+  auto loss = [&](size_t i) {
+    return counts[i] * std::log2(frequencyTable_[i] /
+                                 (frequencyTable_[i] - 1.0));
+  };
+
+  // heap entries are (cost, symbol, frequency of the symbol when pushed),
+  // entries for a symbol whose frequency changed since are skipped.
+  using Entry = std::tuple<double, size_t, uint32_t>;
+  std::priority_queue<Entry> gains;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> losses;
+  auto push = [&](size_t i) {
+    gains.emplace(gain(i), i, frequencyTable_[i]);
+    if (frequencyTable_[i] > 1) {
+      losses.emplace(loss(i), i, frequencyTable_[i]);
+    }
+  };
+  auto top = [&](auto& heap) {
+    auto isStale = [&](const Entry& entry) {
+      return std::get<2>(entry) != frequencyTable_[std::get<1>(entry)];
+    };
+    while (!heap.empty() && isStale(heap.top())) {
+      heap.pop();
+    }
+    return heap.empty() ? frequencyTable_.size() : std::get<1>(heap.top());
+  };
   for (size_t i = 0; i < frequencyTable_.size(); i++) {
-    if (frequencyTable_[i] == 0)
-      assert(cumulativeFrequencyTable_[i + 1] == cumulativeFrequencyTable_[i]);
-    else
-      assert(cumulativeFrequencyTable_[i + 1] > cumulativeFrequencyTable_[i]);
-
-    // calc updated freq
-    frequencyTable_[i] =
-        cumulativeFrequencyTable_[i + 1] - cumulativeFrequencyTable_[i];
+    if (frequencyTable_[i] > 0) {
+      push(i);
+    }
+  }
+
+  // hit the target ...
+  while (newFrequencies < newCumulatedFrequency) {
+    const size_t i = top(gains);
+    frequencyTable_[i]++;
+    newFrequencies++;
+    push(i);
   }
-  //	    for(int i = 0; i<static_cast<int>(freqs.size()); i++){
-  //	    	std::cout << i << ": " << i + min_ << " " << freqs[i] << " " <<
-  // cummulatedFrequencies_[i] << std::endl;
-  //	    }
-  //	    std::cout <<  cummulatedFrequencies_.back() << std::endl;
+  while (newFrequencies > newCumulatedFrequency) {
+    const size_t i = top(losses);
+    frequencyTable_[i]--;
+    newFrequencies--;
+    push(i);
+  }
+
+  // ... and move units while that pays off.
+  while (true) {
+    const size_t to = top(gains);
+    const size_t from = top(losses);
+    if (from == frequencyTable_.size() || from == to ||
+        std::get<0>(gains.top()) <= std::get<0>(losses.top())) {
+      break;
+    }
+    frequencyTable_[to]++;
+    frequencyTable_[from]--;
+    push(to);
+    push(from);
+  }
+
+  buildCumulativeFrequencyTable();
+  assert(cumulativeFrequencyTable_.back() == newCumulatedFrequency);
 }
 
 int SymbolStatistics::minSymbol() const { return min_; }
@@ -0,0 +1,207 @@
+/*
+ * TableCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "librans/TableCache.h"
+
+namespace rans {
+
+CachedTables::CachedTables(std::vector<uint64_t> dictionary)
+    : dictionary_(std::move(dictionary)),
+      view_(dictionary_.data(), dictionary_.size() * sizeof(uint64_t)) {}
+
+const BinaryDictionaryView& CachedTables::getView() const { return view_; }
+
+size_t CachedTables::getProbabilityBits() const {
+  return view_.getProbabilityBits();
+}
+
+DecoderTableView CachedTables::getDecoderTable() const {
+  return view_.getDecoderTable();
+}
+
+bool CachedTables::matches(const SymbolStatistics& stats,
+                           size_t probabilityBits, size_t coderBits,
+                           size_t encoderSymbolBytes) const {
+  const BinaryDictionaryHeader& header = view_.getHeader();
+  if (header.probabilityBits != probabilityBits ||
+      header.coderBits != coderBits ||
+      header.encoderSymbolBytes != encoderSymbolBytes ||
+      !view_.hasDecoderTable() || view_.getMinSymbol() != stats.minSymbol() ||
+      view_.size() != stats.size()) {
+    return false;
+  }
+  const uint32_t* frequency = view_.getFrequencies();
+  for (const auto& entry : stats) {
+    if (*frequency++ != entry.first) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TableCache::TableCache(std::string directory)
+    : directory_(std::move(directory)) {}
+
+size_t TableCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t size = 0;
+  for (const auto& entry : tables_) {
+    size += entry.second.size();
+  }
+  return size;
+}
+
+void TableCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tables_.clear();
+}
+
+uint64_t TableCache::key(const SymbolStatistics& stats,
+                         size_t probabilityBits, Kind kind) {
+  std::vector<uint32_t> description;
+  description.reserve(stats.size() + 5);
+  description.push_back(probabilityBits);
+  description.push_back(kind.coderBits);
+  description.push_back(kind.encoderSymbolBytes);
+  description.push_back(stats.minSymbol());
+  description.push_back(stats.size());
+
+  uint64_t total = 0;
+  for (const auto& entry : stats) {
+    description.push_back(entry.first);
+    total += entry.first;
+  }
+  if (total != static_cast<uint64_t>(1) << probabilityBits) {
+    throw std::runtime_error(
+        "statistics are not normalized to probability bits");
+  }
+
+  return BinaryDictionary::checksum(description.data(),
+                                    description.size() * sizeof(uint32_t));
+}
+
+std::shared_ptr<const CachedTables> TableCache::get(
+    const SymbolStatistics& stats, size_t probabilityBits, Kind kind,
+    Builder build) {
+  const uint64_t key = TableCache::key(stats, probabilityBits, kind);
+  if (auto tables = find(key, stats, probabilityBits, kind)) {
+    return tables;
+  }
+
+  // miss: load or build outside of the lock, so hits on other dictionaries
+  // are not held up.
+  std::shared_ptr<const CachedTables> tables;
+  if (!directory_.empty()) {
+    tables = load(path(key), stats, probabilityBits, kind);
+  }
+  if (!tables) {
+    const std::vector<uint8_t> dictionary = build(stats, probabilityBits);
+    if (!directory_.empty()) {
+      store(path(key), dictionary);
+    }
+    std::vector<uint64_t> aligned(dictionary.size() / sizeof(uint64_t));
+    std::memcpy(aligned.data(), dictionary.data(), dictionary.size());
+    tables = std::make_shared<const CachedTables>(std::move(aligned));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& candidates = tables_[key];
+  for (const auto& candidate : candidates) {
+    if (candidate->matches(stats, probabilityBits, kind.coderBits,
+                           kind.encoderSymbolBytes)) {
+      return candidate;
+    }
+  }
+  candidates.push_back(tables);
+  return tables;
+}
+
+std::shared_ptr<const CachedTables> TableCache::find(
+    uint64_t key, const SymbolStatistics& stats, size_t probabilityBits,
+    Kind kind) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto candidates = tables_.find(key);
+  if (candidates != tables_.end()) {
+    for (const auto& candidate : candidates->second) {
+      if (candidate->matches(stats, probabilityBits, kind.coderBits,
+                             kind.encoderSymbolBytes)) {
+        return candidate;
+      }
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const CachedTables> TableCache::load(
+    const std::string& path, const SymbolStatistics& stats,
+    size_t probabilityBits, Kind kind) {
+  std::ifstream file(path, std::ios_base::binary | std::ios_base::ate);
+  if (!file) {
+    return nullptr;
+  }
+  const std::streamoff size = file.tellg();
+  if (size <= 0 || size % sizeof(uint64_t)) {
+    return nullptr;
+  }
+  std::vector<uint64_t> dictionary(size / sizeof(uint64_t));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(dictionary.data()), size)) {
+    return nullptr;
+  }
+
+  try {
+    auto tables = std::make_shared<const CachedTables>(std::move(dictionary));
+    if (tables->matches(stats, probabilityBits, kind.coderBits,
+                        kind.encoderSymbolBytes)) {
+      return tables;
+    }
+  } catch (std::runtime_error&) {
+    // corrupt or from another machine, rebuild it.
+  }
+  return nullptr;
+}
+
+void TableCache::store(const std::string& path,
+                       const std::vector<uint8_t>& dictionary) {
+  // write under a unique name and rename, so concurrent readers never see a
+  // partial file. The cache only saves work, failing to store is not an
+  // error.
+  std::ostringstream temporary;
+  temporary << path << ".tmp." << getpid() << "."
+            << std::hash<std::thread::id>()(std::this_thread::get_id());
+  {
+    std::ofstream file(temporary.str(), std::ios_base::binary);
+    file.write(reinterpret_cast<const char*>(dictionary.data()),
+               dictionary.size());
+    file.close();
+    if (!file) {
+      std::remove(temporary.str().c_str());
+      return;
+    }
+  }
+  if (std::rename(temporary.str().c_str(), path.c_str()) != 0) {
+    std::remove(temporary.str().c_str());
+  }
+}
+
+std::string TableCache::path(uint64_t key) const {
+  std::ostringstream path;
+  path << directory_ << "/" << std::hex << std::setw(16) << std::setfill('0')
+       << key << FILE_EXTENSION;
+  return path.str();
+}
+
+}  // namespace rans
@@ -0,0 +1,113 @@
+/*
+ * testAdaptiveBlocks.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::throws;
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+std::vector<source_T> roundTrip(const std::vector<source_T>& tokens,
+                                size_t probabilityBits, size_t blockSize,
+                                rans::ThreadPool& pool) {
+  const rans::AdaptiveBlockEncoder<coder_T, stream_T, N> encoder(
+      probabilityBits, blockSize);
+  const rans::EncodedAdaptiveBlocks<stream_T> encoded =
+      encoder.encode(tokens.begin(), tokens.end(), pool);
+  std::vector<source_T> decoded(tokens.size());
+  rans::AdaptiveBlockDecoder<coder_T, stream_T, N>(probabilityBits)
+      .decode(encoded, decoded.begin(), pool);
+  return decoded;
+}
+
+// Two symbols 60000 apart: the table update run-length codes the zeros
+// between them and holds far more frequencies than it has bytes.
+void testWideSparseAlphabet(rans::ThreadPool& pool) {
+  std::vector<uint16_t> tokens(1000);
+  for (size_t i = 0; i < tokens.size(); i++) {
+    tokens[i] = i % 2 ? 60000 : 0;
+  }
+  check((roundTrip<uint32_t, uint16_t, 8>(tokens, 12, 1 << 20, pool) ==
+         tokens),
+        "single block with a wide, sparse alphabet");
+}
+
+// The alphabet moves between blocks, so later blocks get delta coded and
+// replaced tables of a sparse alphabet as well.
+void testWideSparseAlphabetAcrossBlocks(rans::ThreadPool& pool) {
+  std::vector<uint32_t> tokens(40000);
+  for (size_t i = 0; i < tokens.size(); i++) {
+    const uint32_t shift = (i / 10000) * 1000;
+    tokens[i] = (i % 3 ? 100000 : 5) + (i % 7 == 0 ? shift : 0);
+  }
+  check((roundTrip<uint64_t, uint32_t, 4>(tokens, 16, 10000, pool) == tokens),
+        "blocks with a wide, sparse alphabet");
+}
+
+// Blocks whose index claims more symbols than they hold, or that lie past the
+// stream, must not decode.
+void testTamperedIndex(rans::ThreadPool& pool) {
+  std::vector<uint8_t> tokens(4000);
+  for (size_t i = 0; i < tokens.size(); i++) {
+    tokens[i] = (i * 7) % 11;
+  }
+  const rans::AdaptiveBlockEncoder<uint32_t, uint8_t, 4> encoder(12, 1000);
+  const rans::EncodedAdaptiveBlocks<uint8_t> encoded =
+      encoder.encode(tokens.begin(), tokens.end(), pool);
+  const rans::AdaptiveBlockDecoder<uint32_t, uint8_t, 4> decoder(12);
+
+  auto decodes = [&](const rans::EncodedAdaptiveBlocks<uint8_t>& tampered) {
+    std::vector<uint8_t> decoded(tampered.blocks.numSymbols());
+    return !throws([&] { decoder.decode(tampered, decoded.begin(), pool); }) &&
+           decoded == tokens;
+  };
+  check(decodes(encoded), "blocks with an intact index");
+
+  rans::EncodedAdaptiveBlocks<uint8_t> tampered = encoded;
+  for (auto& entry : tampered.blocks.index) {
+    entry.numSymbols *= 100;
+  }
+  check(!decodes(tampered), "blocks with a tampered symbol count");
+
+  tampered = encoded;
+  tampered.blocks.index.back().size += 1000;
+  check(!decodes(tampered), "block past the end of the stream");
+}
+
+// A 13 byte Replace update declaring 2^31 - 1 frequencies, almost all of them
+// a single run of zeros, must be rejected before anything is allocated.
+void testForgedUpdate() {
+  const uint64_t huge = (uint64_t(1) << 31) - 1;
+  std::vector<uint8_t> update;
+  rans::ByteWriter writer(update);
+  writer.put(static_cast<uint8_t>(rans::TableUpdate::Replace));
+  writer.putZigZag(0);
+  writer.putVarint(huge);
+  writer.putVarint(0);
+  writer.putVarint(huge - 1);
+
+  rans::AdaptiveDictionary dictionary(12);
+  rans::ByteReader reader(update.data(), update.size());
+  check(throws([&] { dictionary.decodeUpdate(reader); }),
+        "table update of 2^31 - 1 frequencies");
+}
+}  // namespace
+
+int main() {
+  rans::ThreadPool pool(2);
+  testWideSparseAlphabet(pool);
+  testWideSparseAlphabetAcrossBlocks(pool);
+  testTamperedIndex(pool);
+  testForgedUpdate();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/*
+ * testAlias.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::roundTrip;
+
+// numSymbols symbols out of alphabetSize, spread over a 16 bit range with
+// gaps between them, one of them far more likely than the others.
+std::vector<uint16_t> sparseTokens(size_t numSymbols, uint32_t alphabetSize) {
+  std::vector<uint16_t> tokens(numSymbols);
+  uint32_t x = 1;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    const uint32_t symbol = (x >> 16) % 3 == 0 ? 0 : (x >> 8) % alphabetSize;
+    token = 1000 + symbol * (60000 / alphabetSize);
+  }
+  return tokens;
+}
+
+rans::SymbolStatistics normalized(const std::vector<uint16_t>& tokens,
+                                  size_t probabilityBits) {
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << probabilityBits);
+  return stats;
+}
+
+// Every slot belongs to a symbol as often as its frequency, and the offset
+// of a slot among those of its symbol stays below the frequency.
+void testTable(const rans::SymbolStatistics& stats, size_t probabilityBits,
+               const std::string& what) {
+  const rans::AliasTable table(stats, probabilityBits);
+  check(table.getProbabilityBits() == probabilityBits, what + ": bits");
+  check((table.getNumBuckets() & (table.getNumBuckets() - 1)) == 0,
+        what + ": power of two buckets");
+
+  std::vector<uint32_t> slots(stats.size(), 0);
+  bool owned = true;
+  bool offsets = true;
+  for (uint32_t slot = 0; slot < (1u << probabilityBits) && owned; slot++) {
+    const rans::DecoderTableEntry entry = table[slot];
+    const size_t index = entry.symbol - stats.minSymbol();
+    owned = index < stats.size() && entry.freq == stats[entry.symbol].first;
+    offsets &= slot >= entry.start && slot - entry.start < entry.freq;
+    if (owned) {
+      slots[index]++;
+    }
+  }
+  check(owned, what + ": frequency of the owning symbol");
+  check(offsets, what + ": offset among the slots of the symbol");
+  bool counts = true;
+  for (size_t index = 0; index < stats.size(); index++) {
+    counts &= slots[index] == stats[stats.minSymbol() + index].first;
+  }
+  check(counts, what + ": slots of every symbol");
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+void testRoundTrip(const std::vector<uint16_t>& tokens, size_t probabilityBits,
+                   const std::string& what) {
+  const rans::SymbolStatistics stats = normalized(tokens, probabilityBits);
+  testTable(stats, probabilityBits, what);
+  const rans::AliasEncoder<coder_T, stream_T, N> encoder(stats,
+                                                         probabilityBits);
+  const rans::AliasDecoder<coder_T, stream_T, N> decoder(stats,
+                                                         probabilityBits);
+  check(roundTrip<stream_T>(encoder, decoder, tokens) == tokens,
+        what + ": round trip");
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+void testAlphabets(size_t probabilityBits, const std::string& what) {
+  // one symbol, a non power of two and a power of two number of symbols, and
+  // more symbols than a bucket per symbol leaves room for in few buckets.
+  for (uint32_t alphabetSize : {1, 3, 16, 1000, 5000}) {
+    if (alphabetSize > (1u << probabilityBits)) {
+      continue;
+    }
+    for (size_t numSymbols : {size_t(1), N + 1, size_t(20000)}) {
+      testRoundTrip<coder_T, stream_T, N>(
+          sparseTokens(numSymbols, alphabetSize), probabilityBits,
+          what + ", " + std::to_string(alphabetSize) + " symbols, " +
+              std::to_string(numSymbols) + " tokens");
+    }
+  }
+}
+}  // namespace
+
+int main() {
+  testAlphabets<uint32_t, uint8_t, 4>(16, "8 bit words");
+  testAlphabets<uint32_t, uint16_t, 8>(15, "16 bit words");
+  testAlphabets<uint32_t, uint16_t, 8>(12, "16 bit words at 12 bits");
+  testAlphabets<uint64_t, uint32_t, 2>(20, "64 bit state");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+/*
+ * testBinaryDictionary.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::roundTrip;
+using rans::test::throws;
+
+// A dictionary in memory aligned as the view requires.
+struct Dictionary {
+  explicit Dictionary(const std::vector<uint8_t>& bytes)
+      : words(bytes.size() / sizeof(uint64_t)) {
+    std::memcpy(words.data(), bytes.data(), bytes.size());
+  }
+
+  rans::BinaryDictionaryHeader& header() {
+    return *reinterpret_cast<rans::BinaryDictionaryHeader*>(words.data());
+  }
+
+  uint32_t* frequencies() {
+    return reinterpret_cast<uint32_t*>(
+        reinterpret_cast<uint8_t*>(words.data()) + header().frequenciesOffset);
+  }
+
+  size_t size() const { return words.size() * sizeof(uint64_t); }
+
+  // stores the checksum of the current contents, so a corruption gets past
+  // the checksum and has to be caught by validation.
+  void seal() {
+    header().checksum =
+        rans::BinaryDictionary::dictionaryChecksum(words.data(), size());
+  }
+
+  bool loads(bool verifyChecksum = true) const {
+    return !throws([&] {
+      rans::BinaryDictionaryView(words.data(), size(), verifyChecksum);
+    });
+  }
+
+  std::vector<uint64_t> words;
+};
+
+template <typename coder_T>
+bool serializes(const rans::SymbolStatistics& stats, size_t probabilityBits,
+                bool withDecoderTable) {
+  return !throws([&] {
+    rans::BinaryDictionary::serialize<coder_T>(stats, probabilityBits,
+                                               withDecoderTable);
+  });
+}
+
+std::vector<uint8_t> skewedTokens(size_t numSymbols) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = 1;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    token = (x >> 16) % 7 == 0 ? (x >> 8) % 200 : (x >> 8) % 8;
+  }
+  return tokens;
+}
+
+rans::SymbolStatistics normalized(const std::vector<uint8_t>& tokens,
+                                  size_t probabilityBits) {
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << probabilityBits);
+  return stats;
+}
+
+template <typename coder_T, typename stream_T>
+void testRoundTrip(const char* what) {
+  constexpr size_t PROBABILITY_BITS = 14;
+  const std::vector<uint8_t> tokens = skewedTokens(10000);
+  const rans::SymbolStatistics stats = normalized(tokens, PROBABILITY_BITS);
+  const Dictionary dictionary(
+      rans::BinaryDictionary::serialize<coder_T>(stats, PROBABILITY_BITS));
+  const rans::BinaryDictionaryView view(dictionary.words.data(),
+                                        dictionary.size());
+
+  check(view.getProbabilityBits() == PROBABILITY_BITS &&
+            view.getMinSymbol() == stats.minSymbol() &&
+            view.size() == stats.size(),
+        what);
+  const rans::SymbolStatistics copy = view.getSymbolStatistics();
+  for (size_t i = 0; i < stats.size(); i++) {
+    check(copy[i] == stats[i], what);
+  }
+
+  const rans::DictionaryEncoder<coder_T, stream_T, 4> encoder(
+      view.getEncoderTable<coder_T>(), PROBABILITY_BITS);
+  const rans::DictionaryDecoder<coder_T, stream_T, 4> decoder(
+      view.getDecoderTable());
+  check(roundTrip<stream_T>(encoder, decoder, tokens) == tokens, what);
+}
+
+template <typename coder_T>
+bool buildsDecoder(const rans::BinaryDictionaryView& view) {
+  return !throws([&] { coder_T coder(view.getDecoderTable()); });
+}
+
+template <typename coder_T>
+bool buildsEncoder(const rans::BinaryDictionaryView& view) {
+  return !throws([&] {
+    coder_T coder(view.getEncoderTable<uint32_t>(),
+                  view.getProbabilityBits());
+  });
+}
+
+// A 32 bit dictionary holds up to the 23 probability bits of 8 bit words, the
+// coders of 16 bit words only take 15.
+void testStreamWords() {
+  const std::vector<uint8_t> tokens = skewedTokens(10000);
+  const Dictionary dictionary(rans::BinaryDictionary::serialize<uint32_t>(
+      normalized(tokens, 20), 20));
+  const rans::BinaryDictionaryView view(dictionary.words.data(),
+                                        dictionary.size());
+  using ByteEncoder = rans::DictionaryEncoder<uint32_t, uint8_t, 4>;
+  using ByteDecoder = rans::DictionaryDecoder<uint32_t, uint8_t, 4>;
+  using WordEncoder = rans::DictionaryEncoder<uint32_t, uint16_t, 4>;
+  using WordDecoder = rans::DictionaryDecoder<uint32_t, uint16_t, 4>;
+  check(buildsEncoder<ByteEncoder>(view) && buildsDecoder<ByteDecoder>(view),
+        "20 probability bits with 8 bit words");
+  check(!buildsEncoder<WordEncoder>(view) && !buildsDecoder<WordDecoder>(view),
+        "20 probability bits with 16 bit words");
+}
+
+// Corruptions of the header must fail the checksum.
+void testChecksum() {
+  const rans::SymbolStatistics stats = normalized(skewedTokens(10000), 14);
+  const Dictionary original(
+      rans::BinaryDictionary::serialize<uint32_t>(stats, 14));
+  check(original.loads(), "intact dictionary");
+
+  Dictionary min = original;
+  min.header().min += 1000;
+  check(!min.loads(), "checksum over min");
+  check(min.loads(false), "changed min is otherwise valid");
+
+  Dictionary numSymbols = original;
+  numSymbols.header().numSymbols -= 5;
+  check(!numSymbols.loads(), "checksum over numSymbols");
+
+  Dictionary offset = original;
+  offset.header().encoderTableOffset = offset.header().decoderTableOffset;
+  check(!offset.loads(), "checksum over section offsets");
+
+  Dictionary frequency = original;
+  frequency.frequencies()[0] ^= 1;
+  check(!frequency.loads(), "checksum over frequencies");
+}
+
+// Dictionaries with a valid checksum that the coders can not use.
+void testValidation() {
+  const std::vector<uint8_t> tokens = skewedTokens(10000);
+
+  // at 16 bits the symbol shift alone fills a 32 bit entry.
+  Dictionary wide(rans::BinaryDictionary::serialize<uint64_t>(
+      normalized(tokens, 16), 16));
+  check(wide.loads() && wide.header().decoderEntryBytes == 8,
+        "64 bit decoder entries at 16 probability bits");
+  Dictionary packed32 = wide;
+  packed32.header().decoderEntryBytes = 4;
+  packed32.seal();
+  check(!packed32.loads(), "32 bit entries too narrow for the table");
+
+  // 8 bits with 200 symbols need 24 bit entries: fine in either width.
+  Dictionary narrow(rans::BinaryDictionary::serialize<uint32_t>(
+      normalized(tokens, 8), 8));
+  check(narrow.loads() && narrow.header().decoderEntryBytes == 4,
+        "32 bit decoder entries at 8 probability bits");
+
+  Dictionary probabilityBits = wide;
+  probabilityBits.header().probabilityBits = 32;
+  probabilityBits.seal();
+  check(!probabilityBits.loads(), "probability bits of the packed width");
+
+  Dictionary sum = narrow;
+  sum.frequencies()[0] += 1;
+  sum.seal();
+  check(!sum.loads(), "frequencies not summing up to 1 << probabilityBits");
+
+  Dictionary zeroBits = narrow;
+  zeroBits.header().probabilityBits = 0;
+  zeroBits.header().decoderTableOffset = 0;
+  zeroBits.seal();
+  check(!zeroBits.loads(), "frequencies summing up to a different scale");
+
+  Dictionary min = narrow;
+  min.header().min = std::numeric_limits<int32_t>::max() - 1;
+  min.seal();
+  check(!min.loads(), "symbols past the range of int");
+
+  // 24 bits fit the encoder table of a 64 bit state, not of a 32 bit one.
+  check(!serializes<uint32_t>(normalized(tokens, 24), 24, false),
+        "serialize beyond the probability bits of the coder");
+  const Dictionary encoder64(rans::BinaryDictionary::serialize<uint64_t>(
+      normalized(tokens, 24), 24, false));
+  check(encoder64.loads(), "64 bit encoder table at 24 probability bits");
+  Dictionary encoder32 = encoder64;
+  encoder32.header().coderBits = 32;
+  encoder32.seal();
+  check(!encoder32.loads(), "probability bits beyond the coder");
+  Dictionary coderBits = encoder64;
+  coderBits.header().coderBits = 48;
+  coderBits.seal();
+  check(!coderBits.loads(), "coder of unknown width");
+}
+}  // namespace
+
+int main() {
+  testRoundTrip<uint32_t, uint8_t>("round trip of a 32 bit dictionary");
+  testRoundTrip<uint64_t, uint32_t>("round trip of a 64 bit dictionary");
+  testStreamWords();
+  testChecksum();
+  testValidation();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+/*
+ * testContextModel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::roundTrip;
+using rans::test::throws;
+
+using Encoder = rans::ContextEncoder<uint32_t, uint8_t, 4>;
+using Decoder = rans::ContextDecoder<uint32_t, uint8_t, 4>;
+
+bool encodes(const Encoder& encoder, const std::vector<uint8_t>& tokens) {
+  std::vector<uint8_t> buffer(1024);
+  return !throws([&] {
+    encoder.encode(tokens.begin(), tokens.end(), buffer.data(),
+                   buffer.data() + buffer.size());
+  });
+}
+
+// A model trained on 0/1 alternation only knows 1 after 0 and 0 after 1.
+void testUnseenSymbols() {
+  std::vector<uint8_t> training(10000);
+  for (size_t i = 0; i < training.size(); i++) {
+    training[i] = i % 2;
+  }
+  const rans::ContextStatistics trained(training, 12);
+  const std::vector<uint8_t> serialized = trained.serialize();
+  const rans::ContextStatistics stats(serialized.data(), serialized.size());
+  const Encoder encoder(stats);
+
+  const std::vector<uint8_t> seen = {0, 1, 0, 1, 0, 1, 0};
+  check(roundTrip<uint8_t>(encoder, Decoder(stats), seen) == seen,
+        "round trip of seen transitions");
+
+  check(!encodes(encoder, {0, 0, 1, 1, 0}),
+        "successor that is not in the table of its context");
+  check(!encodes(encoder, {0, 1, 2, 0}), "context past the model");
+  check(!encodes(encoder, {0, 1, 0, 2}), "symbol past the model");
+}
+
+template <typename coder_T>
+bool builds(const rans::ContextStatistics& stats) {
+  return !throws([&] { coder_T coder(stats); });
+}
+
+// 16 bit words limit a 32 bit state to 15 probability bits.
+void testProbabilityBits() {
+  using WordEncoder = rans::ContextEncoder<uint32_t, uint16_t, 4>;
+  using WordDecoder = rans::ContextDecoder<uint32_t, uint16_t, 4>;
+  std::vector<uint8_t> training(10000);
+  for (size_t i = 0; i < training.size(); i++) {
+    training[i] = (i * i + i / 7) % 11;
+  }
+  const rans::ContextStatistics trained(training, 20);
+  const std::vector<uint8_t> serialized = trained.serialize();
+  const rans::ContextStatistics stats(serialized.data(), serialized.size());
+
+  check(!builds<WordEncoder>(stats) && !builds<WordDecoder>(stats),
+        "probability bits beyond 16 bit words");
+  check(builds<Encoder>(stats) && builds<Decoder>(stats),
+        "probability bits within 8 bit words");
+  const rans::ContextStatistics narrow(training, 15);
+  check(builds<WordEncoder>(narrow) && builds<WordDecoder>(narrow),
+        "probability bits of 16 bit words");
+}
+}  // namespace
+
+int main() {
+  testUnseenSymbols();
+  testProbabilityBits();
+  return EXIT_SUCCESS;
+}
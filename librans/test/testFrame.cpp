@@ -0,0 +1,257 @@
+/*
+ * testFrame.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::throws;
+
+template <typename coder_T, typename stream_T, size_t N, typename source_T>
+bool accepts(const rans::Frame& frame) {
+  return !throws([&] { frame.checkCoder<coder_T, stream_T, N, source_T>(); });
+}
+
+bool loads(const std::vector<uint8_t>& buffer) {
+  return !throws([&] { rans::Frame(buffer.data(), buffer.size()); });
+}
+
+// A few symbols thousands apart: the zeros between them are run-length coded,
+// so the dictionary holds far more frequencies than it has bytes.
+std::vector<uint32_t> sparseTokens(size_t numSymbols) {
+  const uint32_t alphabet[] = {7, 5007, 70000, 70001};
+  std::vector<uint32_t> tokens(numSymbols);
+  for (size_t i = 0; i < numSymbols; i++) {
+    tokens[i] = alphabet[(i * i + i / 3) % 4];
+  }
+  return tokens;
+}
+
+void testFrameSparseAlphabet(rans::ThreadPool& pool) {
+  constexpr size_t PROBABILITY_BITS = 14;
+  const std::vector<uint32_t> tokens = sparseTokens(100000);
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << PROBABILITY_BITS);
+
+  const rans::BlockEncoder<uint32_t, uint8_t, 4> encoder(
+      stats, PROBABILITY_BITS, 1 << 14);
+  const std::vector<uint8_t> buffer =
+      rans::Frame::serialize<uint32_t, uint8_t, 4, uint32_t>(
+          stats, PROBABILITY_BITS,
+          encoder.encode(tokens.begin(), tokens.end(), pool));
+
+  const rans::Frame frame(buffer.data(), buffer.size());
+  frame.checkCoder<uint32_t, uint8_t, 4, uint32_t>();
+  std::vector<uint32_t> decoded(tokens.size());
+  rans::BlockDecoder<uint32_t, uint8_t, 4>(frame.getSymbolStatistics(),
+                                           frame.getHeader().probabilityBits)
+      .decode(frame.getPayload<uint8_t>(), frame.getBlockIndex(),
+              decoded.begin(), pool);
+  check(decoded == tokens, "Frame round trip with a sparse alphabet");
+  check(!accepts<uint32_t, uint8_t, 4, uint16_t>(frame),
+        "Frame decoded into a different source type");
+}
+
+void testColumnFrameSparseAlphabet(rans::ThreadPool& pool) {
+  constexpr size_t PROBABILITY_BITS = 16;
+  const std::vector<uint32_t> sparse = sparseTokens(50000);
+  std::vector<uint32_t> dense(30000);
+  for (size_t i = 0; i < dense.size(); i++) {
+    dense[i] = i % 13;
+  }
+  rans::SymbolStatistics sparseStats(sparse);
+  sparseStats.rescaleFrequencyTable(1u << PROBABILITY_BITS);
+  rans::SymbolStatistics denseStats(dense);
+  denseStats.rescaleFrequencyTable(1u << PROBABILITY_BITS);
+
+  rans::ColumnEncoder<uint64_t, uint32_t, 4> encoder;
+  encoder.addColumn(sparseStats, PROBABILITY_BITS);
+  encoder.addColumn(denseStats, PROBABILITY_BITS);
+  const std::vector<uint8_t> buffer = encoder.encode(pool, sparse, dense);
+
+  const rans::ColumnFrame frame(buffer.data(), buffer.size());
+  const rans::ColumnDecoder<uint64_t, uint32_t, 4> decoder(frame);
+  std::vector<uint32_t> decodedSparse(decoder.getNumSymbols(0));
+  std::vector<uint32_t> decodedDense(decoder.getNumSymbols(1));
+  decoder.decode(0, decodedSparse.begin());
+  decoder.decode(1, decodedDense.begin());
+  check(decodedSparse == sparse,
+        "ColumnFrame round trip with a sparse alphabet");
+  check(decodedDense == dense, "ColumnFrame round trip next to it");
+}
+
+// An empty input gives a frame without blocks and payload.
+void testFrameEmpty(rans::ThreadPool& pool) {
+  const std::vector<uint8_t> tokens;
+  const rans::SymbolStatistics stats(0, {1u << 10});
+  const rans::BlockEncoder<uint32_t, uint8_t, 4> encoder(stats, 10, 500);
+  const std::vector<uint8_t> buffer =
+      rans::Frame::serialize<uint32_t, uint8_t, 4, uint8_t>(
+          stats, 10, encoder.encode(tokens.begin(), tokens.end(), pool));
+  const rans::Frame frame(buffer.data(), buffer.size());
+  check(frame.getHeader().numSymbols == 0 && frame.getBlockIndex().empty(),
+        "empty Frame round trip");
+}
+
+// A frame whose block index adds up past 2^64 words must not load.
+void testFrameOverflowingIndex(rans::ThreadPool& pool) {
+  constexpr size_t PROBABILITY_BITS = 10;
+  const std::vector<uint8_t> tokens(1000, 3);
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << PROBABILITY_BITS);
+  const rans::BlockEncoder<uint32_t, uint8_t, 4> encoder(
+      stats, PROBABILITY_BITS, 500);
+  const rans::EncodedBlocks<uint8_t> blocks =
+      encoder.encode(tokens.begin(), tokens.end(), pool);
+  std::vector<uint8_t> buffer =
+      rans::Frame::serialize<uint32_t, uint8_t, 4, uint8_t>(
+          stats, PROBABILITY_BITS, blocks);
+
+  // the index directly follows the dictionary, find it by its first entry.
+  const auto& index = blocks.index;
+  check(index.size() == 2, "two blocks");
+  const uint8_t* first = reinterpret_cast<const uint8_t*>(index.data());
+  const auto position = std::search(buffer.begin(), buffer.end(), first,
+                                    first + sizeof(rans::BlockIndexEntry));
+  check(position != buffer.end(), "block index found");
+  const uint64_t half = uint64_t(1) << 63;
+  const rans::BlockIndexEntry forged[] = {{0, half, index[0].numSymbols},
+                                          {half, half, index[1].numSymbols}};
+  std::memcpy(&*position, forged, sizeof(forged));
+
+  check(!loads(buffer), "Frame with an overflowing block index");
+}
+
+// A frame whose header and index claim more symbols than its blocks hold
+// loads, but must not decode past the end of a block.
+void testFrameTamperedSymbolCount(rans::ThreadPool& pool) {
+  constexpr size_t PROBABILITY_BITS = 10;
+  std::vector<uint8_t> tokens(1000);
+  for (size_t i = 0; i < tokens.size(); i++) {
+    tokens[i] = i % 7;
+  }
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << PROBABILITY_BITS);
+  const rans::BlockEncoder<uint32_t, uint8_t, 4> encoder(
+      stats, PROBABILITY_BITS, 500);
+  const rans::EncodedBlocks<uint8_t> blocks =
+      encoder.encode(tokens.begin(), tokens.end(), pool);
+  std::vector<uint8_t> buffer =
+      rans::Frame::serialize<uint32_t, uint8_t, 4, uint8_t>(
+          stats, PROBABILITY_BITS, blocks);
+
+  const auto& index = blocks.index;
+  const uint8_t* first = reinterpret_cast<const uint8_t*>(index.data());
+  const auto position = std::search(buffer.begin(), buffer.end(), first,
+                                    first + sizeof(rans::BlockIndexEntry));
+  check(position != buffer.end(), "block index found");
+  std::vector<rans::BlockIndexEntry> forged = index;
+  uint64_t numSymbols = 0;
+  for (auto& entry : forged) {
+    entry.numSymbols *= 100;
+    numSymbols += entry.numSymbols;
+  }
+  std::memcpy(&*position, forged.data(),
+              forged.size() * sizeof(rans::BlockIndexEntry));
+  // numSymbols follows magic, version, four byte fields and numLanes.
+  std::memcpy(buffer.data() + 12, &numSymbols, sizeof(numSymbols));
+
+  const rans::Frame frame(buffer.data(), buffer.size());
+  frame.checkCoder<uint32_t, uint8_t, 4, uint8_t>();
+  std::vector<uint8_t> decoded(frame.getHeader().numSymbols);
+  check(throws([&] {
+          rans::BlockDecoder<uint32_t, uint8_t, 4>(frame.getSymbolStatistics(),
+                                                   PROBABILITY_BITS)
+              .decode(frame.getPayload<uint8_t>(), frame.getBlockIndex(),
+                      decoded.begin(), pool);
+        }),
+        "Frame with a tampered symbol count");
+}
+
+// A frame without blocks for the 32 bit coder with 8 bit words around a hand
+// written dictionary: min, the number of frequencies and the run length coded frequencies.
+std::vector<uint8_t> forgedFrame(uint8_t probabilityBits, uint8_t sourceBytes,
+                                 int64_t min, uint64_t numFrequencies,
+                                 const std::vector<uint64_t>& values) {
+  std::vector<uint8_t> dictionary;
+  rans::ByteWriter dictionaryWriter(dictionary);
+  dictionaryWriter.putZigZag(min);
+  dictionaryWriter.putVarint(numFrequencies);
+  for (const uint64_t value : values) {
+    dictionaryWriter.putVarint(value);
+  }
+
+  std::vector<uint8_t> frame = {'r', 'A', 'N', 'S'};
+  rans::ByteWriter writer(frame);
+  writer.put(rans::Frame::VERSION);
+  writer.put(uint8_t(32));
+  writer.put(uint8_t(1));
+  writer.put(probabilityBits);
+  writer.put(sourceBytes);
+  writer.put(uint16_t(4));
+  writer.put(uint64_t(0));
+  writer.put(uint64_t(0));
+  writer.putVarint(dictionary.size());
+  frame.insert(frame.end(), dictionary.begin(), dictionary.end());
+  frame.resize((frame.size() + 7) / 8 * 8, 0);
+  return frame;
+}
+
+// Dictionaries that would make the reader allocate far more than the frame
+// holds, or that do not fit their symbols, must not load.
+void testFrameForgedDictionary() {
+  const uint64_t huge = (uint64_t(1) << 31) - 1;
+  check(!loads(forgedFrame(10, 4, 0, huge, {0, huge - 1})),
+        "dictionary of 2^31 - 1 frequencies");
+  check(!loads(forgedFrame(10, 1, 0, 257, {0, 255, 1 << 10})),
+        "dictionary of 257 byte symbols");
+  check(!loads(forgedFrame(10, 4, int64_t(1) << 40, 1, {1 << 10})),
+        "dictionary starting past INT_MAX");
+  check(!loads(forgedFrame(10, 4, 0, 2, {uint64_t(1) << 32, 1 << 10})),
+        "frequency above UINT32_MAX");
+  check(!loads(forgedFrame(10, 1, -5, 2, {0, 1 << 10})),
+        "dictionary of negative byte symbols");
+  check(!loads(forgedFrame(10, 1, 250, 7, {0, 5, 1 << 10})),
+        "dictionary of byte symbols past 255");
+  check(loads(forgedFrame(10, 1, 250, 6, {0, 4, 1 << 10})),
+        "dictionary up to byte symbol 255");
+  check(loads(forgedFrame(10, 2, 0, 1 << 16, {0, (1 << 16) - 2, 1 << 10})),
+        "dictionary of all 2 byte symbols");
+}
+
+// Frames with more probability bits than the coder supports load, but must
+// not decode: a 32 bit state with 8 bit words takes at most 23.
+void testFrameProbabilityBits() {
+  for (const uint8_t probabilityBits : {23, 24, 28}) {
+    const std::vector<uint8_t> buffer = forgedFrame(
+        probabilityBits, 4, 0, 1, {uint64_t(1) << probabilityBits});
+    const rans::Frame frame(buffer.data(), buffer.size());
+    check(accepts<uint32_t, uint8_t, 4, uint32_t>(frame) ==
+              (probabilityBits <= 23),
+          "probability bits checked against the coder");
+  }
+}
+}  // namespace
+
+int main() {
+  rans::ThreadPool pool(2);
+  testFrameSparseAlphabet(pool);
+  testColumnFrameSparseAlphabet(pool);
+  testFrameEmpty(pool);
+  testFrameOverflowingIndex(pool);
+  testFrameTamperedSymbolCount(pool);
+  testFrameForgedDictionary();
+  testFrameProbabilityBits();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,60 @@
+/*
+ * testHelper.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rans {
+namespace test {
+
+// Fails the test with what unless condition holds.
+inline void check(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+inline void check(bool condition, const std::string& what) {
+  check(condition, what.c_str());
+}
+
+// Whether f() throws a std::runtime_error, the way the library rejects
+// invalid input.
+template <typename F>
+bool throws(F&& f) {
+  try {
+    f();
+  } catch (const std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+// Encodes tokens with encoder into a buffer of stream_T and decodes them again
+// with decoder, for any pair with the interface of Encoder and Decoder.
+template <typename stream_T, typename encoder_T, typename decoder_T,
+          typename source_T>
+std::vector<source_T> roundTrip(const encoder_T& encoder,
+                                const decoder_T& decoder,
+                                const std::vector<source_T>& tokens) {
+  // more than any coder writes per symbol.
+  std::vector<stream_T> buffer(tokens.size() * 4 + 64);
+  const stream_T* stream =
+      encoder.encode(tokens.begin(), tokens.end(), buffer.data(),
+                     buffer.data() + buffer.size());
+  std::vector<source_T> decoded(tokens.size());
+  decoder.decode(stream, decoded.begin(), decoded.size());
+  return decoded;
+}
+
+}  // namespace test
+}  // namespace rans
@@ -0,0 +1,153 @@
+/*
+ * testNormalizer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+
+// -sum_i count_i * log2(frequency_i / total), what the normalizer minimizes.
+double cost(const std::vector<uint32_t>& counts,
+            const std::vector<uint32_t>& frequencies, uint32_t total) {
+  double bits = 0;
+  for (size_t i = 0; i < counts.size(); i++) {
+    if (counts[i] > 0) {
+      bits -= counts[i] *
+              std::log2(static_cast<double>(frequencies[i]) / total);
+    }
+  }
+  return bits;
+}
+
+// The lowest cost of all tables that sum up to total and give every seen
+// symbol, and only those, a frequency, by trying all of them.
+double exhaustiveCost(const std::vector<uint32_t>& counts, uint32_t total) {
+  std::vector<size_t> seen;
+  for (size_t i = 0; i < counts.size(); i++) {
+    if (counts[i] > 0) {
+      seen.push_back(i);
+    }
+  }
+  std::vector<uint32_t> frequencies(counts.size(), 0);
+  double best = std::numeric_limits<double>::infinity();
+  auto search = [&](auto& self, size_t next, uint32_t left) -> void {
+    const size_t symbol = seen[next];
+    if (next + 1 == seen.size()) {
+      frequencies[symbol] = left;
+      best = std::min(best, cost(counts, frequencies, total));
+      return;
+    }
+    // at least 1 for every seen symbol still to come.
+    const uint32_t rest = seen.size() - next - 1;
+    for (uint32_t frequency = 1; frequency + rest <= left; frequency++) {
+      frequencies[symbol] = frequency;
+      self(self, next + 1, left - frequency);
+    }
+  };
+  search(search, 0, total);
+  return best;
+}
+
+// Normalizes counts to total and checks the table: exact sum, cumulated
+// starts, a frequency for exactly the seen symbols. Returns the frequencies.
+std::vector<uint32_t> normalize(const std::vector<uint32_t>& counts,
+                                uint32_t total, const std::string& what) {
+  rans::SymbolStatistics stats(0, counts);
+  stats.rescaleFrequencyTable(total);
+  check(stats.size() == counts.size(), what + ": alphabet kept");
+
+  std::vector<uint32_t> frequencies;
+  uint64_t cumulated = 0;
+  for (const auto& entry : stats) {
+    const size_t symbol = frequencies.size();
+    check(entry.second == cumulated, what + ": cumulated starts");
+    check((entry.first > 0) == (counts[symbol] > 0),
+          what + ": frequency for exactly the seen symbols");
+    cumulated += entry.first;
+    frequencies.push_back(entry.first);
+  }
+  check(cumulated == total, what + ": frequencies sum up to the total");
+  return frequencies;
+}
+
+std::vector<uint32_t> randomCounts(uint32_t* x, size_t numSymbols,
+                                   uint32_t maxCount) {
+  std::vector<uint32_t> counts(numSymbols);
+  for (auto& count : counts) {
+    *x = *x * 1103515245 + 12345;
+    // some symbols unseen, some rare, some frequent.
+    const uint32_t r = *x >> 8;
+    count = r % 4 == 0 ? 0 : r % 3 == 0 ? 1 + r % 3 : 1 + (r >> 4) % maxCount;
+  }
+  // the first symbol is always seen.
+  counts[0] += 1;
+  return counts;
+}
+
+// Small tables: the normalizer finds a table as cheap as the best one.
+void testOptimal() {
+  uint32_t x = 1;
+  for (size_t numSymbols = 1; numSymbols <= 5; numSymbols++) {
+    for (uint32_t total : {5u, 8u, 16u, 32u}) {
+      for (uint32_t maxCount : {3u, 50u, 1000u}) {
+        for (size_t round = 0; round < 20; round++) {
+          const std::vector<uint32_t> counts =
+              randomCounts(&x, numSymbols, maxCount);
+          size_t numSeen = 0;
+          for (uint32_t count : counts) {
+            numSeen += count > 0;
+          }
+          if (numSeen > total) {
+            continue;
+          }
+          const std::string what = std::to_string(numSymbols) +
+                                   " symbols to " + std::to_string(total);
+          const double best = exhaustiveCost(counts, total);
+          const double normalized =
+              cost(counts, normalize(counts, total, what), total);
+          check(normalized <= best + 1e-9 * (1 + best),
+                what + ": as cheap as the exhaustive search");
+        }
+      }
+    }
+  }
+}
+
+// Large and skewed tables, where the old rescaler had to repair zeros.
+void testLarge() {
+  uint32_t x = 7;
+  for (size_t numSymbols : {100, 1000, 65536}) {
+    for (uint32_t total : {1u << 12, 1u << 16, 1u << 20}) {
+      if (numSymbols > total) {
+        continue;
+      }
+      std::vector<uint32_t> counts = randomCounts(&x, numSymbols, 5);
+      // one symbol takes almost everything.
+      counts[numSymbols / 2] = 100000000;
+      normalize(counts, total,
+                std::to_string(numSymbols) + " skewed symbols to " +
+                    std::to_string(total));
+    }
+  }
+  // as many seen symbols as units of frequency.
+  normalize(std::vector<uint32_t>(256, 1000), 256, "one unit per symbol");
+}
+}  // namespace
+
+int main() {
+  testOptimal();
+  testLarge();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/*
+ * testOutputArena.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::throws;
+
+void testBuffer() {
+  rans::OutputBuffer<uint16_t> buffer(10, 8);
+  check(buffer.capacity() == 16, "capacity rounded up to whole chunks");
+  check(buffer.end() - buffer.begin() == 16, "end behind the capacity");
+  buffer.reserve(3);
+  check(buffer.capacity() == 16, "reserve never shrinks");
+  buffer.reserve(17);
+  check(buffer.capacity() == 24, "reserve grows by whole chunks");
+  check(rans::OutputBuffer<uint16_t>().capacity() == 0, "empty buffer");
+  check(throws([] { rans::OutputBuffer<uint16_t> buffer(10, 0); }),
+        "chunk size 0 rejected");
+}
+
+void testArena() {
+  rans::OutputArena<uint8_t> arena(100);
+  {
+    auto small = arena.acquire(50);
+    auto large = arena.acquire(250);
+    check(small->capacity() == 100 && large->capacity() == 300,
+          "new buffers rounded up to whole chunks");
+    check(arena.getNumIdle() == 0, "leased buffers are not idle");
+  }
+  check(arena.getNumIdle() == 2 && arena.getIdleCapacity() == 400,
+        "buffers returned on release");
+
+  {
+    const uint8_t* largeData = nullptr;
+    {
+      // the smallest idle buffer that is large enough.
+      auto lease = arena.acquire(150);
+      check(lease->capacity() == 300, "smallest buffer that fits");
+      largeData = lease->begin();
+      check(arena.getNumIdle() == 1 && arena.getIdleCapacity() == 100,
+            "the other buffer stays idle");
+    }
+    auto lease = arena.acquire(300);
+    check(lease->begin() == largeData, "an exact fit is reused as is");
+  }
+
+  {
+    // nothing fits: the largest idle buffer grows, the others stay.
+    auto lease = arena.acquire(450);
+    check(lease->capacity() == 500, "largest buffer grown");
+    check(arena.getNumIdle() == 1 && arena.getIdleCapacity() == 100,
+          "smaller buffer left idle");
+    auto other = arena.acquire(10);
+    check(other->capacity() == 100 && arena.getNumIdle() == 0,
+          "smaller buffer reused");
+    auto fresh = arena.acquire(10);
+    check(fresh->capacity() == 100, "new buffer when none is idle");
+  }
+  check(arena.getNumIdle() == 3 && arena.getIdleCapacity() == 700,
+        "all buffers idle again");
+
+  arena.clear();
+  check(arena.getNumIdle() == 0 && arena.getIdleCapacity() == 0,
+        "clear frees idle buffers");
+}
+
+// Tokens of the least likely symbols only, so every step writes as many
+// words as it can.
+std::vector<uint8_t> rareTokens(size_t numSymbols) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = 1;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    token = 1 + (x >> 16) % 255;
+  }
+  return tokens;
+}
+
+std::vector<uint8_t> uniformTokens(size_t numSymbols) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = 7;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    token = x >> 24;
+  }
+  return tokens;
+}
+
+// Encodes into a buffer of exactly maxCompressedSize words, leased from an
+// arena that does not round up, and one word less, which either still fits
+// or is rejected.
+template <typename coder_T, typename stream_T, size_t N>
+void testBound(const rans::SymbolStatistics& stats,
+               const std::vector<uint8_t>& tokens, size_t probabilityBits,
+               const std::string& what) {
+  const size_t bound = rans::maxCompressedSize<coder_T, stream_T, N>(
+      tokens.size(), probabilityBits);
+  const rans::Encoder<coder_T, stream_T, N> encoder(stats, probabilityBits);
+  const rans::Decoder<coder_T, stream_T, N> decoder(stats, probabilityBits);
+  rans::OutputArena<stream_T> arena(1);
+
+  auto lease = arena.acquire(bound);
+  check(lease->capacity() == bound, what + ": exact capacity");
+  const stream_T* begin = encoder.encode(tokens.begin(), tokens.end(),
+                                         lease->begin(), lease->end());
+  check(begin >= lease->begin(), what + ": stream within the bound");
+  std::vector<uint8_t> decoded(tokens.size());
+  decoder.decode(begin, lease->end(), decoded.begin(), decoded.size());
+  check(decoded == tokens, what + ": round trip at the bound");
+
+  std::vector<stream_T> smaller(bound - 1);
+  bool fits = true;
+  const bool rejected = throws([&] {
+    begin = encoder.encode(tokens.begin(), tokens.end(), smaller.data(),
+                           smaller.data() + smaller.size());
+  });
+  if (!rejected) {
+    std::vector<uint8_t> again(tokens.size());
+    decoder.decode(begin, smaller.data() + smaller.size(), again.begin(),
+                   again.size());
+    fits = again == tokens;
+  }
+  check(rejected || fits, what + ": one word less fits or is rejected");
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+void testBounds(size_t probabilityBits, const std::string& what) {
+  // one likely symbol and many rare ones.
+  std::vector<uint32_t> counts(256, 1);
+  counts[0] = 1000000;
+  rans::SymbolStatistics skewed(0, counts);
+  skewed.rescaleFrequencyTable(1u << probabilityBits);
+  for (size_t numSymbols : {size_t(0), size_t(1), N - 1, N, N + 1,
+                            size_t(1000), size_t(10003)}) {
+    const std::string length = what + ", " + std::to_string(numSymbols);
+    testBound<coder_T, stream_T, N>(skewed, rareTokens(numSymbols),
+                                    probabilityBits, length + " rare symbols");
+    const std::vector<uint8_t> tokens = uniformTokens(numSymbols);
+    if (tokens.empty()) {
+      continue;
+    }
+    rans::SymbolStatistics uniform(tokens);
+    uniform.rescaleFrequencyTable(1u << probabilityBits);
+    testBound<coder_T, stream_T, N>(uniform, tokens, probabilityBits,
+                                    length + " uniform symbols");
+  }
+}
+}  // namespace
+
+int main() {
+  testBuffer();
+  testArena();
+  testBounds<uint32_t, uint8_t, 1>(14, "8 bit words");
+  testBounds<uint32_t, uint8_t, 4>(20, "8 bit words at 20 bits");
+  testBounds<uint32_t, uint16_t, 8>(15, "16 bit words");
+  testBounds<uint64_t, uint32_t, 2>(20, "32 bit words");
+  return EXIT_SUCCESS;
+}
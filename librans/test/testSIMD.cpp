@@ -0,0 +1,178 @@
+/*
+ * testSIMD.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::throws;
+
+// Symbols of a signed source_T are centered around 0, so half are negative.
+template <typename source_T>
+source_T toSymbol(uint32_t symbol, uint32_t alphabetSize) {
+  if constexpr (std::is_signed_v<source_T>) {
+    return static_cast<source_T>(static_cast<int32_t>(symbol) -
+                                 static_cast<int32_t>(alphabetSize / 2));
+  } else {
+    return static_cast<source_T>(symbol);
+  }
+}
+
+template <typename source_T>
+std::vector<source_T> skewedTokens(size_t numSymbols, uint32_t alphabetSize) {
+  std::vector<source_T> tokens(numSymbols);
+  uint32_t x = 1;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    // geometric: every further symbol half as likely.
+    uint32_t symbol = __builtin_ctz((x >> 8) | (1u << 20));
+    token = toSymbol<source_T>(
+        symbol < alphabetSize ? symbol : (x >> 4) % alphabetSize,
+        alphabetSize);
+  }
+  return tokens;
+}
+
+// Every kernel the machine supports writes the same stream as the others and
+// as Encoder<uint32_t, uint16_t, 8>, and decodes the stream of every kernel.
+template <typename source_T>
+void testKernels(const std::vector<source_T>& tokens, size_t probabilityBits,
+                 const std::string& what) {
+  using stream_t = uint16_t;
+  rans::SymbolStatistics stats(tokens.begin(), tokens.end());
+  stats.rescaleFrequencyTable(1u << probabilityBits);
+  const std::vector<rans::SIMDLevel> levels = rans::supportedSIMDLevels();
+
+  std::vector<stream_t> reference(tokens.size() * 2 + 64);
+  const stream_t* referenceBegin =
+      rans::Encoder<uint32_t, stream_t, 8>(stats, probabilityBits)
+          .encode(tokens.begin(), tokens.end(), reference.data(),
+                  reference.data() + reference.size());
+  const std::vector<stream_t> expected(
+      referenceBegin, static_cast<const stream_t*>(reference.data()) +
+                          reference.size());
+
+  std::vector<std::vector<stream_t>> streams;
+  for (rans::SIMDLevel level : levels) {
+    const rans::SIMDEncoder<source_T> encoder(stats, probabilityBits, level);
+    check(encoder.getLevel() == level, what + ": encoder level");
+    std::vector<stream_t> buffer(tokens.size() * 2 + 64);
+    const stream_t* begin =
+        encoder.encode(tokens.data(), tokens.data() + tokens.size(),
+                       buffer.data(), buffer.data() + buffer.size());
+    streams.emplace_back(
+        begin, static_cast<const stream_t*>(buffer.data()) + buffer.size());
+    check(streams.back() == expected,
+          what + ": stream of " + rans::toString(level));
+  }
+
+  for (rans::SIMDLevel level : levels) {
+    const rans::SIMDDecoder<source_T> decoder(stats, probabilityBits, level);
+    for (size_t i = 0; i < streams.size(); i++) {
+      std::vector<source_T> decoded(tokens.size());
+      decoder.decode(streams[i].data(), streams[i].data() + streams[i].size(),
+                     decoded.data(), decoded.size());
+      check(decoded == tokens, what + ": " + rans::toString(level) +
+                                   " decoding the stream of " +
+                                   rans::toString(levels[i]));
+    }
+  }
+}
+
+template <typename source_T>
+void testLengths(uint32_t alphabetSize, const std::string& what) {
+  // whole groups of 8 and every tail length.
+  for (size_t numSymbols : {1, 7, 8, 9, 15, 16, 17, 1000, 4099, 65541}) {
+    const std::string length = what + ", " + std::to_string(numSymbols);
+    const std::vector<source_T> skewed =
+        skewedTokens<source_T>(numSymbols, alphabetSize);
+    testKernels(skewed, 15, length + " skewed symbols");
+    testKernels(skewed, 10, length + " skewed symbols at 10 bits");
+
+    std::vector<source_T> uniform(numSymbols);
+    for (size_t i = 0; i < numSymbols; i++) {
+      uniform[i] =
+          toSymbol<source_T>((i * 7919) % alphabetSize, alphabetSize);
+    }
+    testKernels(uniform, 15, length + " uniform symbols");
+  }
+}
+
+bool constructs(const rans::SymbolStatistics& stats, size_t probabilityBits) {
+  return !throws([&] { rans::SIMDDecoder<uint8_t>(stats, probabilityBits); });
+}
+
+// The decoder tables are only built for frequencies that fill them exactly.
+void testDecoderTables() {
+  const std::vector<uint8_t> tokens = skewedTokens<uint8_t>(1000, 50);
+  const rans::SymbolStatistics counts(tokens.begin(), tokens.end());
+  rans::SymbolStatistics stats = counts;
+  stats.rescaleFrequencyTable(1u << 12);
+  check(constructs(stats, 12), "normalized frequencies");
+  check(!constructs(stats, 13) && !constructs(stats, 11),
+        "frequencies of another scale");
+  check(!constructs(counts, 12), "frequencies not normalized");
+  check(!constructs(stats, 16) && !constructs(stats, 40),
+        "more than 15 probability bits");
+}
+
+// Every kernel throws on a truncated stream instead of reading past its end.
+void testTruncated() {
+  using stream_t = uint16_t;
+  const std::vector<uint8_t> tokens = skewedTokens<uint8_t>(100000, 256);
+  rans::SymbolStatistics stats(tokens.begin(), tokens.end());
+  stats.rescaleFrequencyTable(1u << 15);
+
+  std::vector<stream_t> buffer(tokens.size() * 2 + 64);
+  const stream_t* begin =
+      rans::SIMDEncoder<uint8_t>(stats, 15, rans::SIMDLevel::Scalar)
+          .encode(tokens.data(), tokens.data() + tokens.size(), buffer.data(),
+                  buffer.data() + buffer.size());
+  const size_t streamSize = buffer.data() + buffer.size() - begin;
+
+  for (rans::SIMDLevel level : rans::supportedSIMDLevels()) {
+    const rans::SIMDDecoder<uint8_t> decoder(stats, 15, level);
+    for (size_t size : {size_t(0), size_t(15), size_t(16), size_t(40),
+                        streamSize / 2, streamSize - 1}) {
+      // exactly sized, so a sanitizer catches any read behind it.
+      std::unique_ptr<stream_t[]> prefix(new stream_t[size]);
+      std::copy(begin, begin + size, prefix.get());
+      std::vector<uint8_t> decoded(tokens.size());
+      check(throws([&] {
+              decoder.decode(prefix.get(), prefix.get() + size,
+                             decoded.data(), decoded.size());
+            }),
+            rans::toString(level) + " decoding " + std::to_string(size) +
+                " of " + std::to_string(streamSize) + " words");
+    }
+  }
+}
+}  // namespace
+
+int main() {
+  check(rans::supportedSIMDLevels().front() == rans::SIMDLevel::Scalar,
+        "scalar kernel always supported");
+  check(rans::isSupported(rans::detectSIMDLevel()), "detected level");
+  testLengths<uint8_t>(256, "8 bit source");
+  testLengths<uint16_t>(1000, "16 bit source");
+  testLengths<uint32_t>(20, "32 bit source");
+  testLengths<int8_t>(256, "signed 8 bit source");
+  testLengths<int16_t>(1000, "signed 16 bit source");
+  testLengths<int32_t>(20, "signed 32 bit source");
+  testDecoderTables();
+  testTruncated();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/*
+ * testSparse.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+
+template <typename source_T>
+std::vector<source_T> roundTrip(const rans::SparseSymbolStatistics& stats,
+                                const std::vector<source_T>& values) {
+  constexpr size_t PROBABILITY_BITS = 12;
+  const rans::SparseEncoder<uint64_t, uint32_t, 4> encoder(stats,
+                                                           PROBABILITY_BITS);
+  const rans::EncodedSparse<uint32_t> encoded =
+      encoder.encode(values.data(), values.data() + values.size());
+  std::vector<source_T> decoded(values.size());
+  rans::SparseDecoder<uint64_t, uint32_t, 4>(stats, PROBABILITY_BITS)
+      .decode(encoded, decoded.data());
+  return decoded;
+}
+
+// Values that were not seen while building the statistics are escaped with
+// the full width of the source type.
+void testUnseenValues() {
+  std::vector<int32_t> training(5000);
+  for (size_t i = 0; i < training.size(); i++) {
+    training[i] = (i % 5) * 1000 + (i % 17 == 0 ? 7 * i : 0);
+  }
+  rans::SparseSymbolStatistics stats(training, 5);
+  stats.rescaleFrequencyTable(1u << 12);
+
+  check(roundTrip(stats, training) == training, "round trip of training data");
+  const std::vector<int32_t> unseen = {0,       -1,   1000, 2147483647,
+                                       -123456, 4000, 3,    -2147483647 - 1};
+  check(roundTrip(stats, unseen) == unseen,
+        "values outside the escapes seen in training");
+}
+
+// Statistics built without escapes can still escape.
+void testNoTrainingEscapes() {
+  const std::vector<uint64_t> training = {1, 2, 3, 1, 2, 1};
+  rans::SparseSymbolStatistics stats(training, 16);
+  stats.rescaleFrequencyTable(1u << 12);
+
+  const std::vector<uint64_t> values = {1, 4, 2, uint64_t(1) << 63, 3};
+  check(roundTrip(stats, values) == values, "escapes without training escapes");
+}
+}  // namespace
+
+int main() {
+  testUnseenValues();
+  testNoTrainingEscapes();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/*
+ * testStreamEncoder.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+
+constexpr size_t PROBABILITY_BITS = 14;
+
+using StreamEncoder = rans::StreamEncoder<uint32_t, uint16_t, 4, uint8_t>;
+using Decoder = rans::Decoder<uint32_t, uint16_t, 4>;
+
+struct Chunk {
+  std::vector<uint16_t> stream;
+  size_t numSymbols;
+};
+
+std::vector<uint8_t> skewedTokens(size_t numSymbols) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = 1;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    token = (x >> 16) % 5 == 0 ? (x >> 8) % 100 : (x >> 8) % 4;
+  }
+  return tokens;
+}
+
+// The chunks decoded one after the other.
+std::vector<uint8_t> decode(const std::vector<Chunk>& chunks,
+                            const rans::SymbolStatistics& stats) {
+  const Decoder decoder(stats, PROBABILITY_BITS);
+  std::vector<uint8_t> decoded;
+  for (const Chunk& chunk : chunks) {
+    const size_t offset = decoded.size();
+    decoded.resize(offset + chunk.numSymbols);
+    const uint16_t* stream = chunk.stream.data();
+    decoder.decode(stream, stream + chunk.stream.size(),
+                   decoded.begin() + offset, chunk.numSymbols);
+  }
+  return decoded;
+}
+
+// Writes of writeSize symbols, which need not divide the window, come out as
+// full windows and one shorter last chunk on flush.
+template <typename container_T>
+void testChunks(const std::vector<uint8_t>& tokens, size_t windowSize,
+                size_t writeSize, const std::string& what) {
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << PROBABILITY_BITS);
+
+  std::vector<Chunk> chunks;
+  StreamEncoder encoder(
+      stats, PROBABILITY_BITS, windowSize,
+      [&](const uint16_t* begin, const uint16_t* end, size_t numSymbols) {
+        chunks.push_back({std::vector<uint16_t>(begin, end), numSymbols});
+      });
+  check(encoder.getWindowSize() == windowSize, what + ": window size");
+
+  for (size_t i = 0; i < tokens.size(); i += writeSize) {
+    const container_T piece(tokens.begin() + i,
+                            tokens.begin() + std::min(i + writeSize,
+                                                      tokens.size()));
+    encoder.write(piece.begin(), piece.end());
+  }
+  check(chunks.size() == tokens.size() / windowSize,
+        what + ": full windows emitted while writing");
+  encoder.flush();
+  encoder.flush();
+  check(chunks.size() == (tokens.size() + windowSize - 1) / windowSize,
+        what + ": flush emits the rest once");
+
+  for (size_t i = 0; i < chunks.size(); i++) {
+    const size_t expected =
+        std::min(windowSize, tokens.size() - i * windowSize);
+    check(chunks[i].numSymbols == expected, what + ": symbols per chunk");
+  }
+  check(decode(chunks, stats) == tokens, what + ": round trip");
+}
+}  // namespace
+
+int main() {
+  const std::vector<uint8_t> tokens = skewedTokens(10007);
+  for (size_t windowSize : {1, 3, 1000, 4096, 20000}) {
+    for (size_t writeSize : {1, 7, 999, 1001, 10007}) {
+      const std::string what = "window of " + std::to_string(windowSize) +
+                               ", writes of " + std::to_string(writeSize);
+      testChunks<std::vector<uint8_t>>(tokens, windowSize, writeSize, what);
+      if (writeSize >= 999) {
+        // writes that are not random access go symbol by symbol.
+        testChunks<std::list<uint8_t>>(tokens, windowSize, writeSize,
+                                       what + " from a list");
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
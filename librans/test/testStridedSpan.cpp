@@ -0,0 +1,118 @@
+/*
+ * testStridedSpan.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+
+// fields of different widths and alignments, so the stride differs from the
+// size of any of them.
+struct Record {
+  uint16_t pad;
+  uint8_t time;
+  uint32_t id;
+  uint16_t charge;
+};
+
+std::vector<Record> records(size_t numRecords) {
+  std::vector<Record> result(numRecords);
+  uint32_t x = 1;
+  for (size_t i = 0; i < numRecords; i++) {
+    x = x * 1103515245 + 12345;
+    const uint32_t r = x >> 8;
+    result[i] = {static_cast<uint16_t>(i), static_cast<uint8_t>(r % 7 * 3),
+                 static_cast<uint32_t>(i * 31),
+                 static_cast<uint16_t>(r % 5 == 0 ? r % 40000 : r % 16)};
+  }
+  return result;
+}
+
+bool sameRecord(const Record& a, const Record& b) {
+  return a.pad == b.pad && a.time == b.time && a.id == b.id &&
+         a.charge == b.charge;
+}
+
+void testIterator() {
+  std::vector<Record> data = records(10);
+  const auto span = rans::fieldOf(data, &Record::id);
+  check(span.size() == data.size() && span.stride() == sizeof(Record),
+        "size and stride of the span");
+  check(span.end() - span.begin() == 10 && span.begin() < span.end(),
+        "distance between iterators");
+  auto it = span.end();
+  bool elements = true;
+  for (size_t i = data.size(); i-- > 0;) {
+    --it;
+    elements &= &*it == &data[i].id && &span[i] == &data[i].id &&
+                span.begin()[i] == data[i].id;
+  }
+  check(elements && it == span.begin(), "elements walking backwards");
+  span[3] = 77;
+  check(data[3].id == 77, "write through the span");
+
+  const std::vector<Record> empty;
+  check(rans::fieldOf(empty, &Record::time).empty(), "empty span");
+}
+
+// Encodes field from the records, decodes it into the same field of records
+// that differ in all other fields, which stay as they were.
+template <typename coder_T, typename stream_T, size_t N, typename field_T>
+void testRoundTrip(const std::vector<Record>& data, field_T Record::*field,
+                   size_t probabilityBits, const std::string& what) {
+  const auto source = rans::fieldOf(data, field);
+  rans::SymbolStatistics stats(source);
+  stats.rescaleFrequencyTable(1u << probabilityBits);
+  const rans::Encoder<coder_T, stream_T, N> encoder(stats, probabilityBits);
+  const rans::Decoder<coder_T, stream_T, N> decoder(stats, probabilityBits);
+
+  std::vector<stream_T> buffer(
+      rans::maxCompressedSize<coder_T, stream_T, N>(data.size(),
+                                                    probabilityBits));
+  const stream_T* stream =
+      encoder.encode(source.begin(), source.end(), buffer.data(),
+                     buffer.data() + buffer.size());
+
+  std::vector<Record> decoded = records(data.size() + 1);
+  const std::vector<Record> before = decoded;
+  decoder.decode(stream, rans::fieldOf(decoded, field).begin(), data.size());
+
+  bool fields = true;
+  bool others = true;
+  for (size_t i = 0; i < data.size(); i++) {
+    fields &= decoded[i].*field == data[i].*field;
+    Record restored = decoded[i];
+    restored.*field = before[i].*field;
+    others &= sameRecord(restored, before[i]);
+  }
+  check(fields, what + ": decoded field");
+  check(others, what + ": other fields untouched");
+  check(sameRecord(decoded.back(), before.back()),
+        what + ": nothing written behind the last record");
+}
+}  // namespace
+
+int main() {
+  testIterator();
+  for (size_t numRecords : {1, 5, 1000, 100001}) {
+    const std::vector<Record> data = records(numRecords);
+    const std::string what = std::to_string(numRecords) + " records";
+    testRoundTrip<uint32_t, uint8_t, 4>(data, &Record::time, 16,
+                                        what + ", 8 bit field");
+    testRoundTrip<uint32_t, uint16_t, 2>(data, &Record::charge, 15,
+                                         what + ", 16 bit field");
+    testRoundTrip<uint64_t, uint32_t, 1>(data, &Record::id, 20,
+                                         what + ", 32 bit field");
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+ * testSymbolAdaptive.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::roundTrip;
+
+// Mostly symbol 0 with bursts of others, so the model keeps adapting.
+std::vector<uint8_t> skewedTokens(size_t numSymbols, size_t alphabetSize) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = 1;
+  for (size_t i = 0; i < numSymbols; i++) {
+    x = x * 1103515245 + 12345;
+    const bool burst = (i / 500) % 3 == 2;
+    tokens[i] = burst || (x >> 16) % 4 == 0 ? (x >> 8) % alphabetSize : 0;
+  }
+  return tokens;
+}
+
+template <typename coder_T, typename stream_T, size_t N>
+void testRoundTrip(size_t alphabetSize, const char* what) {
+  const rans::SymbolAdaptiveEncoder<coder_T, stream_T, N> encoder(
+      alphabetSize);
+  const rans::SymbolAdaptiveDecoder<coder_T, stream_T, N> decoder(
+      alphabetSize);
+
+  // below N, tails of every length and whole groups only.
+  for (size_t numSymbols : {size_t(0), size_t(1), N - 1, N, N + 1,
+                            size_t(5000), size_t(5000) + N - 1}) {
+    const std::vector<uint8_t> tokens =
+        skewedTokens(numSymbols, alphabetSize);
+    check(roundTrip<stream_T>(encoder, decoder, tokens) == tokens, what);
+  }
+}
+
+bool sameCDF(const rans::AdaptiveCDF& a, const rans::AdaptiveCDF& b) {
+  for (uint32_t symbol = 0; symbol < a.size(); symbol++) {
+    if (a.start(symbol) != b.start(symbol) ||
+        a.frequency(symbol) != b.frequency(symbol)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// find and update give the same results as their portable versions, which
+// builds without SSE2 use.
+void testScalarCDF(size_t alphabetSize) {
+  rans::AdaptiveCDF cdf(alphabetSize);
+  rans::AdaptiveCDF scalar(alphabetSize);
+  const std::vector<uint8_t> tokens = skewedTokens(3000, alphabetSize);
+  for (size_t i = 0; i < tokens.size(); i++) {
+    cdf.update(tokens[i]);
+    scalar.updateScalar(tokens[i]);
+    check(sameCDF(cdf, scalar), "update and updateScalar");
+
+    // the slots around every start, every slot now and then.
+    for (uint32_t symbol = 0; symbol < alphabetSize; symbol++) {
+      const uint32_t start = cdf.start(symbol);
+      for (uint32_t slot = start > 0 ? start - 1 : 0; slot <= start + 1;
+           slot++) {
+        check(cdf.find(slot) == scalar.findScalar(slot),
+              "find and findScalar");
+      }
+    }
+    if (i % 1000 == 0) {
+      for (uint32_t slot = 0; slot < 1u << rans::AdaptiveCDF::PROBABILITY_BITS;
+           slot++) {
+        const uint32_t symbol = cdf.find(slot);
+        check(symbol == scalar.findScalar(slot) && cdf.start(symbol) <= slot &&
+                  slot < cdf.start(symbol) + cdf.frequency(symbol),
+              "symbol owning every slot");
+      }
+    }
+  }
+}
+}  // namespace
+
+int main() {
+  for (size_t alphabetSize : {2, 16}) {
+    testRoundTrip<uint32_t, uint8_t, 4>(alphabetSize,
+                                        "round trip with 8 bit words");
+    testRoundTrip<uint32_t, uint16_t, 8>(alphabetSize,
+                                         "round trip with 16 bit words");
+    testRoundTrip<uint64_t, uint32_t, 3>(alphabetSize,
+                                         "round trip with a 64 bit state");
+    testScalarCDF(alphabetSize);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+/*
+ * testTableCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::roundTrip;
+
+constexpr size_t PROBABILITY_BITS = 12;
+
+std::vector<uint8_t> tokens(size_t numSymbols, uint32_t seed) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = seed;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    token = (x >> 16) % 5 == 0 ? (x >> 8) % 64 : (x >> 8) % 4;
+  }
+  return tokens;
+}
+
+rans::SymbolStatistics normalized(const std::vector<uint8_t>& tokens) {
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << PROBABILITY_BITS);
+  return stats;
+}
+
+template <typename coder_T>
+std::string path(const std::string& directory,
+                 const rans::SymbolStatistics& stats) {
+  std::ostringstream path;
+  path << directory << "/" << std::hex << std::setw(16) << std::setfill('0')
+       << rans::TableCache::key<coder_T>(stats, PROBABILITY_BITS)
+       << rans::TableCache::FILE_EXTENSION;
+  return path.str();
+}
+
+bool exists(const std::string& path) { return std::ifstream(path).good(); }
+
+void write(const std::string& path, const std::vector<uint8_t>& bytes) {
+  std::ofstream file(path, std::ios_base::binary | std::ios_base::trunc);
+  file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// The cached tables code the data of their dictionary.
+bool codes(const rans::CachedTables& tables,
+           const std::vector<uint8_t>& source) {
+  const rans::DictionaryEncoder<uint32_t, uint8_t, 4> encoder(
+      tables.getEncoderTable<uint32_t>(), tables.getProbabilityBits());
+  const rans::DictionaryDecoder<uint32_t, uint8_t, 4> decoder(
+      tables.getDecoderTable());
+  return roundTrip<uint8_t>(encoder, decoder, source) == source;
+}
+
+void testMemory() {
+  const std::vector<uint8_t> a = tokens(10000, 1);
+  const std::vector<uint8_t> b = tokens(10000, 2);
+  const rans::SymbolStatistics statsA = normalized(a);
+  const rans::SymbolStatistics statsB = normalized(b);
+
+  rans::TableCache cache;
+  const auto tablesA = cache.get<uint32_t>(statsA, PROBABILITY_BITS);
+  check(tablesA == cache.get<uint32_t>(statsA, PROBABILITY_BITS),
+        "hit on the same dictionary");
+  check(cache.size() == 1, "one table per dictionary");
+  check(tablesA->matches<uint32_t>(statsA, PROBABILITY_BITS) &&
+            !tablesA->matches<uint32_t>(statsB, PROBABILITY_BITS) &&
+            !tablesA->matches<uint64_t>(statsA, PROBABILITY_BITS),
+        "tables match their dictionary and coder only");
+  check(codes(*tablesA, a), "round trip with cached tables");
+
+  const auto tablesB = cache.get<uint32_t>(statsB, PROBABILITY_BITS);
+  check(tablesB != tablesA && codes(*tablesB, b),
+        "different dictionary, different tables");
+  check(cache.get<uint64_t>(statsA, PROBABILITY_BITS) != tablesA,
+        "different coder, different tables");
+  check(cache.size() == 3, "tables of every dictionary and coder");
+
+  cache.clear();
+  check(cache.size() == 0, "clear");
+}
+
+void testDirectory() {
+  char directoryTemplate[] = "/tmp/testTableCacheXXXXXX";
+  check(mkdtemp(directoryTemplate) != nullptr, "temporary directory");
+  const std::string directory = directoryTemplate;
+
+  const std::vector<uint8_t> a = tokens(10000, 1);
+  const std::vector<uint8_t> b = tokens(10000, 2);
+  const rans::SymbolStatistics statsA = normalized(a);
+  const rans::SymbolStatistics statsB = normalized(b);
+  const std::string pathA = path<uint32_t>(directory, statsA);
+
+  // store: built tables are written to the directory.
+  rans::TableCache(directory).get<uint32_t>(statsA, PROBABILITY_BITS);
+  check(exists(pathA), "store built tables");
+
+  // load: another cache on the directory reads them back.
+  {
+    rans::TableCache cache(directory);
+    const auto tables = cache.get<uint32_t>(statsA, PROBABILITY_BITS);
+    check(tables->matches<uint32_t>(statsA, PROBABILITY_BITS) &&
+              codes(*tables, a),
+          "load stored tables");
+  }
+
+  // mismatch: a file holding another dictionary is rebuilt and replaced.
+  write(pathA,
+        rans::BinaryDictionary::serialize<uint32_t>(statsB, PROBABILITY_BITS));
+  {
+    rans::TableCache cache(directory);
+    const auto tables = cache.get<uint32_t>(statsA, PROBABILITY_BITS);
+    check(tables->matches<uint32_t>(statsA, PROBABILITY_BITS) &&
+              codes(*tables, a),
+          "rebuild tables of another dictionary");
+  }
+  {
+    rans::TableCache cache(directory);
+    const auto tables = cache.get<uint32_t>(statsA, PROBABILITY_BITS);
+    check(tables->matches<uint32_t>(statsA, PROBABILITY_BITS),
+          "replace tables of another dictionary");
+  }
+
+  // corrupt: a damaged file is rebuilt as well.
+  std::vector<uint8_t> damaged =
+      rans::BinaryDictionary::serialize<uint32_t>(statsA, PROBABILITY_BITS);
+  damaged[damaged.size() / 2] ^= 0xff;
+  write(pathA, damaged);
+  {
+    rans::TableCache cache(directory);
+    const auto tables = cache.get<uint32_t>(statsA, PROBABILITY_BITS);
+    check(tables->matches<uint32_t>(statsA, PROBABILITY_BITS) &&
+              codes(*tables, a),
+          "rebuild corrupt tables");
+  }
+  write(pathA, {1, 2, 3});
+  {
+    rans::TableCache cache(directory);
+    check(codes(*cache.get<uint32_t>(statsA, PROBABILITY_BITS), a),
+          "rebuild truncated tables");
+  }
+
+  std::remove(pathA.c_str());
+  rmdir(directory.c_str());
+}
+}  // namespace
+
+int main() {
+  testMemory();
+  testDirectory();
+  return EXIT_SUCCESS;
+}
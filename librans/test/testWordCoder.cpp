@@ -0,0 +1,146 @@
+/*
+ * testWordCoder.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "librans/rans.h"
+#include "testHelper.h"
+
+namespace {
+
+using rans::test::check;
+using rans::test::throws;
+
+using stream_t = uint16_t;
+
+constexpr size_t GUARD_WORDS = 16;
+constexpr stream_t GUARD = 0xa5a5;
+
+// Coder<uint32_t, uint16_t> renormalizes without branches: it always stores
+// the word in front of ptr, and reads the one in front of ptr when it takes
+// none. Both have to stay inside a buffer of maxCompressedSize words, and
+// inside the stream when decoding.
+template <size_t N>
+void testBuffer(const std::vector<uint8_t>& tokens, size_t probabilityBits,
+                const std::string& what) {
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << probabilityBits);
+  const size_t maxSize = rans::maxCompressedSize<uint32_t, stream_t, N>(
+      tokens.size(), probabilityBits);
+  const rans::Encoder<uint32_t, stream_t, N> encoder(stats, probabilityBits);
+  const rans::Decoder<uint32_t, stream_t, N> decoder(stats, probabilityBits);
+
+  // exactly sized, so a sanitizer catches any access before or behind it.
+  std::unique_ptr<stream_t[]> exact(new stream_t[maxSize]);
+  const stream_t* begin =
+      encoder.encode(tokens.begin(), tokens.end(), exact.get(),
+                     exact.get() + maxSize);
+  check(begin >= exact.get(), what + ": stream inside the buffer");
+  const size_t streamSize = exact.get() + maxSize - begin;
+
+  // decoded from an exactly sized copy of the stream only.
+  std::unique_ptr<stream_t[]> stream(new stream_t[streamSize]);
+  std::copy(begin, begin + streamSize, stream.get());
+  std::vector<uint8_t> decoded(tokens.size());
+  decoder.decode(stream.get(), decoded.begin(), decoded.size());
+  check(decoded == tokens, what + ": round trip");
+
+  // the same without a sanitizer: guard words around the buffer stay intact.
+  std::vector<stream_t> guarded(GUARD_WORDS + maxSize + GUARD_WORDS, GUARD);
+  stream_t* outputBegin = guarded.data() + GUARD_WORDS;
+  const stream_t* guardedBegin = encoder.encode(
+      tokens.begin(), tokens.end(), outputBegin, outputBegin + maxSize);
+  check(std::all_of(guarded.begin(), guarded.begin() + GUARD_WORDS,
+                    [](stream_t word) { return word == GUARD; }),
+        what + ": nothing written before outputBegin");
+  check(std::all_of(guarded.end() - GUARD_WORDS, guarded.end(),
+                    [](stream_t word) { return word == GUARD; }),
+        what + ": nothing written behind outputEnd");
+  check(static_cast<size_t>(outputBegin + maxSize - guardedBegin) ==
+                streamSize &&
+            std::equal(begin, begin + streamSize, guardedBegin),
+        what + ": same stream");
+}
+
+std::vector<uint8_t> skewedTokens(size_t numSymbols) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = 1;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    // mostly one symbol: most steps take or emit no word.
+    token = (x >> 16) % 64 == 0 ? (x >> 8) % 256 : 0;
+  }
+  return tokens;
+}
+
+std::vector<uint8_t> uniformTokens(size_t numSymbols) {
+  std::vector<uint8_t> tokens(numSymbols);
+  uint32_t x = 7;
+  for (auto& token : tokens) {
+    x = x * 1103515245 + 12345;
+    token = x >> 24;
+  }
+  return tokens;
+}
+
+template <typename coder_T>
+bool builds(const rans::SymbolStatistics& stats, size_t probabilityBits) {
+  return !throws([&] { coder_T coder(stats, probabilityBits); });
+}
+
+// 16 bit words limit a 32 bit state to 15 probability bits, where 8 bit words
+// allow 23.
+void testProbabilityBits() {
+  using WordEncoder = rans::Encoder<uint32_t, stream_t, 4>;
+  using WordDecoder = rans::Decoder<uint32_t, stream_t, 4>;
+  using ByteEncoder = rans::Encoder<uint32_t, uint8_t, 4>;
+  using ByteDecoder = rans::Decoder<uint32_t, uint8_t, 4>;
+  const std::vector<uint8_t> tokens = uniformTokens(10000);
+  for (size_t probabilityBits : {16, 20}) {
+    rans::SymbolStatistics stats(tokens);
+    stats.rescaleFrequencyTable(1u << probabilityBits);
+    check(!builds<WordEncoder>(stats, probabilityBits) &&
+              !builds<WordDecoder>(stats, probabilityBits) &&
+              !builds<rans::AliasEncoder<uint32_t, stream_t, 4>>(
+                  stats, probabilityBits),
+          "probability bits beyond 16 bit words");
+    check(builds<ByteEncoder>(stats, probabilityBits) &&
+              builds<ByteDecoder>(stats, probabilityBits),
+          "probability bits within 8 bit words");
+  }
+  rans::SymbolStatistics stats(tokens);
+  stats.rescaleFrequencyTable(1u << 15);
+  check(builds<WordEncoder>(stats, 15) && builds<WordDecoder>(stats, 15),
+        "probability bits of 16 bit words");
+}
+
+template <size_t N>
+void testLanes(const std::string& what) {
+  for (size_t numSymbols : {size_t(1), size_t(2), size_t(3), size_t(4),
+                            size_t(5), size_t(1000), size_t(1003),
+                            size_t(100001)}) {
+    const std::string length = what + ", " + std::to_string(numSymbols);
+    testBuffer<N>(skewedTokens(numSymbols), 15, length + " skewed symbols");
+    testBuffer<N>(skewedTokens(numSymbols), 12,
+                  length + " skewed symbols at 12 bits");
+    testBuffer<N>(uniformTokens(numSymbols), 15, length + " uniform symbols");
+    testBuffer<N>(uniformTokens(numSymbols), 8,
+                  length + " uniform symbols at 8 bits");
+  }
+}
+}  // namespace
+
+int main() {
+  testLanes<1>("1 state");
+  testLanes<4>("4 states");
+  testProbabilityBits();
+  return EXIT_SUCCESS;
+}